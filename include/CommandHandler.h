@@ -5,12 +5,19 @@
 #include "MainMotor.h"
 #include "OscillationMotor.h"
 #include "SequenceStateMachine.h"
+#include "EmergencyStop.h"
+#include "MemoryMonitor.h"
+#include "StepTrace.h"
+#include "MotionTuning.h"
 
 class CommandHandler {
 private:
     MainMotor& motor1;
     OscillationMotor& motor2;
     SequenceStateMachine& sequence;
+    EmergencyStop& eStop;
+    StepTrace& stepTrace;
+    MotionTuning& tuning;
     
     String inputString;
     bool stringComplete;
@@ -20,8 +27,21 @@ private:
         inputString.trim();
         inputString.toLowerCase();
         
+        // Motion commands are refused while an emergency stop is latched
+        if (eStop.isLatched() && (inputString == "go1" || inputString == "home" ||
+                                  inputString == "home2" || inputString == "seq1" ||
+                                  inputString == "resume" ||
+                                  inputString.startsWith("jog "))) {
+            Serial.println(F("Error: Emergency stop latched - send 'reset' first"));
+        }
+        
+        // Position moves and jog share Motor 1
+        else if (motor1.isJogging() && (inputString == "go1" || inputString == "seq1")) {
+            Serial.println(F("Error: Motor 1 jogging - send 'jogstop' first"));
+        }
+        
         // Motor 1 commands
-        if (inputString == "go1") {
+        else if (inputString == "go1") {
             motor1.setDirection(Config::CW_RIGHT);
             delay(Config::Timing::DIR_CHANGE_DELAY_MS);
             delayMicroseconds(Config::Timing::DIR_SETUP_US);
@@ -39,6 +59,55 @@ private:
             Serial.println(F("Motor 1: Stopped"));
         }
         
+        // Motor 1 velocity (jog) mode
+        else if (inputString == "jogstop") {
+            if (motor1.isJogging()) {
+                motor1.stopVelocity();
+                Serial.println(F("Motor 1: Jog ramping down"));
+            } else {
+                Serial.println(F("Motor 1: Not jogging"));
+            }
+        }
+        else if (inputString == "jog") {
+            Serial.print(F("Motor 1 jog: "));
+            if (motor1.isJogging()) {
+                Serial.print(motor1.getVelocity());
+                Serial.print(F(" RPM, target "));
+                Serial.print(motor1.getTargetVelocity());
+                Serial.println(F(" RPM"));
+            } else {
+                Serial.println(F("off"));
+            }
+        }
+        else if (inputString.startsWith("jog ")) {
+            String rpmValue = inputString.substring(4);
+            rpmValue.trim();
+            char first = (rpmValue.length() > 0) ? rpmValue.charAt(0) : '\0';
+            float rpm = rpmValue.toFloat();
+            
+            if (!((first >= '0' && first <= '9') || first == '.' || first == '-')) {
+                Serial.println(F("Usage: jog <rpm> (negative = CCW/LEFT)"));
+            } else if (sequence.isActive() || (motor1.isEnabled() && !motor1.isJogging())) {
+                Serial.println(F("Error: Motor 1 busy - stop the sequence or move first"));
+            } else if (rpm > Config::Motor1::MAX_RPM || rpm < -Config::Motor1::MAX_RPM) {
+                Serial.print(F("Error: Jog speed must be between -"));
+                Serial.print(Config::Motor1::MAX_RPM);
+                Serial.print(F(" and "));
+                Serial.print(Config::Motor1::MAX_RPM);
+                Serial.println(F(" RPM"));
+            } else if (fabs(rpm) < Config::Motor1::JOG_MIN_RPM && (rpm != 0.0f || !motor1.isJogging())) {
+                // Slower than this sends no pulses but would still hold Motor 1 as jogging
+                Serial.print(F("Error: Jog speed must be at least "));
+                Serial.print(Config::Motor1::JOG_MIN_RPM);
+                Serial.println(F(" RPM (0 only while jogging)"));
+            } else {
+                Serial.print(motor1.isJogging() ? F("Motor 1: Jog target ") : F("Motor 1: Jog started, target "));
+                motor1.setTargetVelocity(rpm);
+                Serial.print(rpm);
+                Serial.println(F(" RPM"));
+            }
+        }
+        
         // Motor 2 commands
         else if (inputString == "home" || inputString == "home2") {
             motor2.startHoming();
@@ -55,6 +124,13 @@ private:
             sequence.stop();
             Serial.println(F("EMERGENCY STOP: All motors stopped"));
         }
+        else if (inputString == "reset") {
+            if (!eStop.isLatched()) {
+                Serial.println(F("No emergency stop latched"));
+            } else {
+                eStop.reset();
+            }
+        }
         
         // Sequence commands
         else if (inputString == "seq1") {
@@ -67,6 +143,12 @@ private:
         else if (inputString == "softstop") {
             sequence.softStop();
         }
+        else if (inputString == "pause") {
+            sequence.pause();
+        }
+        else if (inputString == "resume") {
+            sequence.resume();
+        }
         
         // Direction mode commands
         else if (inputString == "sync" || inputString == "same") {
@@ -84,6 +166,82 @@ private:
             Serial.println(sequence.getSameDirection() ? F("SAME direction") : F("OPPOSITE direction"));
         }
         
+        // Sequence throughput and health counters
+        else if (inputString == "perf") {
+            sequence.getPerf().print();
+        }
+        else if (inputString == "perf reset") {
+            sequence.getPerf().reset();
+        }
+        else if (inputString == "perf save") {
+            if (motor1.isEnabled() || motor2.isEnabled()) {
+                Serial.println(F("Error: Stop all motors before 'perf save'"));
+            } else {
+                Serial.print(F("Perf: saved to EEPROM ("));
+                Serial.print((unsigned long)sequence.getPerf().save());
+                Serial.println(F(" bytes)"));
+            }
+        }
+        
+        // Memory report (free RAM low-water mark, heap fragmentation)
+        else if (inputString == "mem") {
+            MemoryMonitor::printReport();
+        }
+        
+        // Step trace recorder (must be checked BEFORE startsWith)
+        else if (inputString == "tracedump") {
+            stepTrace.dump();
+        }
+        else if (inputString == "tracestatus") {
+            stepTrace.printStatus();
+        }
+        else if (inputString.startsWith("trace")) {
+            String nValue = inputString.substring(5);
+            nValue.trim();
+            long everyN = (nValue.length() > 0) ? nValue.toInt() : Config::Trace::DEFAULT_DECIMATION;
+            
+            if (!Config::Trace::ENABLED) {
+                Serial.println(F("Error: Step trace disabled in Config::Trace"));
+            } else if (everyN >= 1 && everyN <= 255) {
+                stepTrace.arm((uint8_t)everyN);
+                stepTrace.printStatus();
+            } else {
+                Serial.println(F("Error: Trace interval must be between 1 and 255 steps"));
+            }
+        }
+        
+        // Runtime tuning ("get", "get m1.rpm", "set m1.rpm 20", "save", "defaults")
+        else if (inputString == "get") {
+            tuning.printAll();
+        }
+        else if (inputString.startsWith("get ")) {
+            String name = inputString.substring(4);
+            name.trim();
+            tuning.print(name);
+        }
+        else if (inputString.startsWith("set ")) {
+            String args = inputString.substring(4);
+            args.trim();
+            int space = args.indexOf(' ');
+            String name = args.substring(0, space < 0 ? args.length() : space);
+            String value = (space < 0) ? String("") : args.substring(space + 1);
+            value.trim();
+            char first = (value.length() > 0) ? value.charAt(0) : '\0';
+            
+            // toFloat() returns 0 for garbage, so require a number to start with
+            if ((first >= '0' && first <= '9') || first == '.' || first == '-') {
+                tuning.set(name, value.toFloat());
+            } else {
+                Serial.println(F("Usage: set <name> <value> - send 'get' for names"));
+            }
+        }
+        else if (inputString == "save") {
+            tuning.save();
+        }
+        else if (inputString == "defaults") {
+            tuning.restoreDefaults();
+        }
+        
         // Get current Motor 1 degree setting (must be checked BEFORE startsWith)
         else if (inputString == "deg" || inputString == "degrees") {
             Serial.print(F("Motor 1 current setting: "));
@@ -137,6 +295,9 @@ private:
         Serial.println(F("  stop1     - Stop Motor 1"));
         Serial.println(F("  deg<n>    - Set Motor 1 degrees (0-1080°, e.g., deg360, deg720)"));
         Serial.println(F("  deg       - Show current Motor 1 degree setting"));
+        Serial.println(F("  jog <rpm> - Continuous rotation / change speed (negative = CCW)"));
+        Serial.println(F("  jog       - Show jog speed"));
+        Serial.println(F("  jogstop   - Ramp down and stop jog"));
         Serial.println(F("\nMotor 2:"));
         Serial.println(F("  home      - Home Motor 2 (find limit switches)"));
         Serial.println(F("  stop2     - Stop Motor 2"));
@@ -144,20 +305,37 @@ private:
         Serial.println(F("  seq1     - Start oscillation sequence"));
         Serial.println(F("  stopseq  - Stop sequence immediately"));
         Serial.println(F("  softstop - Stop after current movement (requires re-homing)"));
+        Serial.println(F("  pause    - Decelerate to a stop mid-sweep, keep progress"));
+        Serial.println(F("  resume   - Re-accelerate and continue a paused sweep"));
         Serial.println(F("\nEmergency:"));
         Serial.println(F("  stopall  - STOP ALL (motors + sequence)"));
+        Serial.println(F("  Ctrl-X   - Immediate stop from interrupt (latched)"));
+        Serial.println(F("  reset    - Clear latched emergency stop"));
         Serial.println(F("\nConfiguration:"));
         Serial.println(F("  sync     - Motor1 follows Motor2 (same direction)"));
         Serial.println(F("  opposite - Motor1 opposite to Motor2"));
         Serial.println(F("  mode     - Show current direction mode"));
+        Serial.println(F("\nTuning (applied when no axis is moving):"));
+        Serial.println(F("  get          - Show all tunable parameters"));
+        Serial.println(F("  get <name>   - Show one parameter"));
+        Serial.println(F("  set <name> <value> - Stage a new value (m1.rpm, m1.accel, ...)"));
+        Serial.println(F("  save         - Store staged values in EEPROM"));
+        Serial.println(F("  defaults     - Stage compiled defaults"));
+        Serial.println(F("\nDiagnostics:"));
+        Serial.println(F("  mem      - Free RAM, stack low-water mark, heap fragmentation"));
+        Serial.println(F("  perf     - Sequence counters (perf reset / perf save)"));
+        Serial.println(F("  trace<n> - Record every nth step from next move start (default 1)"));
+        Serial.println(F("  tracestatus - Show step trace state"));
+        Serial.println(F("  tracedump   - Send recorded step trace (binary)"));
         Serial.println(F("\nOther:"));
         Serial.println(F("  help     - Show this help message"));
         Serial.println(F("==========================\n"));
     }
     
 public:
-    CommandHandler(MainMotor& m1, OscillationMotor& m2, SequenceStateMachine& seq)
-        : motor1(m1), motor2(m2), sequence(seq), 
+    CommandHandler(MainMotor& m1, OscillationMotor& m2, SequenceStateMachine& seq,
+                   EmergencyStop& es, StepTrace& trace, MotionTuning& tune)
+        : motor1(m1), motor2(m2), sequence(seq), eStop(es), stepTrace(trace), tuning(tune),
           inputString(""), stringComplete(false), motor1CustomDegrees(0.0f) {
         inputString.reserve(50);
     }
@@ -173,6 +351,15 @@ public:
         while (Serial.available()) {
             char inChar = (char)Serial.read();
             
+            if (inChar == (char)Config::EStop::SERIAL_BYTE) {
+                // Normally acted on from interrupt context already; catch up
+                // if the poll has not got here yet, so no later command runs
+                noInterrupts();
+                eStop.pollSerial();
+                interrupts();
+                continue;
+            }
+            
             if (inChar == '\n' || inChar == '\r') {
                 if (inputString.length() > 0) {
                     stringComplete = true;
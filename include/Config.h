@@ -9,6 +9,13 @@ namespace Config {
     constexpr bool CCW_LEFT = false;    // Counter-clockwise / Left direction (LOW)
     constexpr bool CW_RIGHT = true;     // Clockwise / Right direction (HIGH)
     
+    // Ramp shapes for PROFILE_SHAPE (speed over position inside the accel/decel zones)
+    enum class ProfileShape : uint8_t {
+        POWER_CURVE,    // progress^POWER_CURVE: one pow() per profile update
+        TRAPEZOID,      // Constant acceleration: sqrt(progress), POWER_CURVE unused
+        S_CURVE         // Jerk-limited 7-segment ramp from a flash table, POWER_CURVE unused
+    };
+    
     // Motor 1 Parameters (Main Motor)
     namespace Motor1 {
         constexpr uint8_t STEP_PIN = 6;              // Digital pin for step pulses (one pulse = one microstep)
@@ -17,14 +24,22 @@ namespace Config {
         constexpr uint8_t MICROSTEPS = 8;            // Microstepping driver setting (1/8 step)
         constexpr uint8_t GEAR_RATIO = 20;           // Gear reduction ratio (20:1)
         constexpr float TARGET_RPM = 15.0f;          // Target speed at output shaft (after gear reduction)
+        constexpr float MAX_RPM = 25.0f;             // Upper limit for runtime tuning ('set m1.rpm')
         constexpr float TEST_DEGREES = 180.0f;       // Movement angle for 'go1' test command (half rotation)
         constexpr float SEQUENCE_DEGREES = 720.0f;   // Movement angle for seq1 oscillation (2 full rotations)
         constexpr float MAX_DEGREES = 1080.0f;       // Maximum allowed rotation (3 full rotations = safety limit)
         // Speed Profile (calculated relative to 360° rotation for consistent acceleration)
         constexpr float ACCEL_ZONE = 0.05f;          // Acceleration zone (5% of 360° = 18°)
         constexpr float DECEL_ZONE = 0.05f;          // Deceleration zone (5% of 360° = 18°)
+        constexpr ProfileShape PROFILE_SHAPE = ProfileShape::POWER_CURVE;  // Ramp shape (fixed at compile time)
         constexpr float POWER_CURVE = 0.8f;          // Power curve exponent for acceleration/deceleration profile (0.8 = gentle curve)
+        constexpr float S_CURVE_JERK = 0.5f;         // S_CURVE only: share of the ramp time spent changing acceleration (0 < x <= 1)
         constexpr float MIN_SPEED_FACTOR = 0.1f;     // Minimum speed as fraction of target speed (0.1 = 10% minimum to prevent stalling)
+        constexpr uint8_t PROFILE_UPDATE_STEPS = 16; // Steps between speed profile updates (1600 accel steps = 100 updates per ramp)
+        // Velocity (jog) mode
+        constexpr float JOG_ACCEL_RPM_PER_S = 10.0f; // Velocity ramp rate, also through zero on reversal (0 -> 15 RPM in 1.5 s)
+        constexpr float JOG_MIN_RPM = 1.5f;          // Below this no pulses are sent; also the slowest jog step timer period
+        constexpr unsigned long JOG_UPDATE_MS = 10;  // Velocity ramp update interval (time-based: no steps near zero)
     }
     
     // Motor 2 Parameters (Oscillation Motor)
@@ -38,12 +53,16 @@ namespace Config {
         constexpr uint8_t MICROSTEPS = 8;                        // Microstepping driver setting (1/8 step)
         constexpr uint8_t GEAR_RATIO = 50;                       // Gear reduction ratio (50:1)
         constexpr float TARGET_RPM = 5.0f;                       // Target speed at output shaft (after gear reduction)
+        constexpr float MAX_RPM = 10.0f;                         // Upper limit for runtime tuning ('set m2.rpm')
         constexpr float OFFSET_DEGREES = 10.0f;                  // Offset from right limit switch after homing (safety margin)
         // Speed Profile (calculated relative to 360° rotation for consistent acceleration)
-        constexpr float ACCEL_ZONE = 0.10f;          // Acceleration zone (10% of 360° = 36°)
-        constexpr float DECEL_ZONE = 0.10f;          // Deceleration zone (10% of 360° = 36°)
+        constexpr float ACCEL_ZONE = 0.018f;         // Acceleration zone (1.8% of 360° = 6.5°, 1440 steps; leaves a cruise in a 60° range)
+        constexpr float DECEL_ZONE = 0.018f;         // Deceleration zone (1.8% of 360° = 6.5°, 1440 steps)
+        constexpr ProfileShape PROFILE_SHAPE = ProfileShape::POWER_CURVE;  // Ramp shape (fixed at compile time)
         constexpr float POWER_CURVE = 0.8f;          // Power curve exponent for acceleration/deceleration profile (0.8 = gentle curve)
+        constexpr float S_CURVE_JERK = 0.5f;         // S_CURVE only: share of the ramp time spent changing acceleration (0 < x <= 1)
         constexpr float MIN_SPEED_FACTOR = 0.1f;     // Minimum speed as fraction of target speed (0.1 = 10% minimum to prevent stalling)
+        constexpr uint8_t PROFILE_UPDATE_STEPS = 16; // Steps between speed profile updates (1440 accel steps = 90 updates per ramp)
     }
     
     // Timing
@@ -60,6 +79,46 @@ namespace Config {
         constexpr unsigned long BAUD_RATE = 115200;  // Serial port baud rate (bits per second)
     }
     
+    // Emergency Stop
+    namespace EStop {
+        constexpr uint8_t SERIAL_BYTE = 0x18;            // Reserved byte (Ctrl-X): halts all motion from interrupt context
+        constexpr bool INPUT_ENABLED = false;            // If true, INPUT_PIN is wired as a hardware e-stop input
+        constexpr uint8_t INPUT_PIN = CONTROLLINO_IN0;   // Interrupt-capable input (NC contact to GND, open = stop)
+    }
+    
+    // Step Trace Recorder
+    namespace Trace {
+        constexpr bool ENABLED = true;                   // Compile in the recorder (costs 2 * BUFFER_SIZE bytes RAM)
+        constexpr uint16_t BUFFER_SIZE = 512;            // Number of 16-bit step timestamp entries
+        constexpr uint8_t DEFAULT_DECIMATION = 1;        // Record every Nth step when 'trace' is given no number
+    }
+    
+    // Runtime Tuning ('set'/'get'/'save' commands, EEPROM persistence)
+    namespace Tuning {
+        constexpr int EEPROM_ADDRESS = 0;                // Start of the stored parameter block
+        constexpr uint8_t EEPROM_VERSION = 1;            // Bump when TuningValues changes layout
+        constexpr uint16_t EEPROM_MAGIC = 0x5446;        // "FT" - marks a written block
+        constexpr float MIN_RPM = 0.5f;                  // Lower limit for 'set m1.rpm' / 'set m2.rpm'
+        constexpr float MIN_ZONE = 0.005f;               // Lower limit for 'set mN.accel/decel' (0 = no ramp)
+        constexpr float MAX_OFFSET_DEGREES = 45.0f;      // Upper limit for 'set m2.offset'
+    }
+    
+    // Sequence Counters ('perf' command, EEPROM persistence)
+    namespace Perf {
+        constexpr int EEPROM_ADDRESS = 64;               // After the tuning record at 0
+        constexpr uint8_t EEPROM_VERSION = 2;            // Bump when SequenceCounters changes layout
+        constexpr uint16_t EEPROM_MAGIC = 0x5053;        // "PS" - marks a written record
+        constexpr unsigned long SAVE_INTERVAL_MIN = 0;   // Save every N minutes when both motors stand (0 = only 'perf save')
+    }
+    
+    // Idle Power Mode
+    namespace Power {
+        constexpr bool STOP_IDLE_TIMERS = true;              // Stop a step timer while its axis is disabled (no ISR load at idle)
+        constexpr unsigned long DRIVER_OFF_DELAY_MS = 30000; // Motor2 driver off (ENABLE_PIN HIGH) after this long without a move (0 = always on)
+        constexpr unsigned long DRIVER_WAKE_US = 2000;       // Driver enable to first step pulse (charge pump / wake-up time)
+        constexpr bool IDLE_SLEEP = true;                    // Idle-sleep in loop()'s wait while both step timers are stopped
+    }
+    
     // Sequence Behavior
     namespace Sequence {
         constexpr bool AUTO_START_AFTER_HOMING = true;      // If true, seq1 starts automatically after Motor2 homing completes
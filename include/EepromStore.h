@@ -0,0 +1,71 @@
+#ifndef EEPROM_STORE_H
+#define EEPROM_STORE_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <util/crc16.h>
+#include <stddef.h>
+
+// Versioned, CRC-checked records in EEPROM (tuning, sequence counters).
+//
+// Each record is stored as magic, layout version, payload size, payload and
+// a CRC-16 over all of them. A record is only loaded back if every field
+// matches, so a layout change (bump the version) or a torn write falls back
+// to the caller's defaults. Writes go through EEPROM.put(), which skips
+// unchanged bytes; each changed byte still takes ~3.3 ms and blocks the
+// caller, so save only while the motors are stopped.
+
+namespace EepromStore {
+    enum class LoadResult : uint8_t {
+        OK,
+        BLANK,      // Magic not found: never saved
+        INVALID     // Version, size or CRC mismatch
+    };
+
+    template <typename T>
+    struct Record {
+        uint16_t magic;
+        uint8_t version;
+        uint8_t size;       // sizeof(T)
+        T values;
+        uint16_t crc;       // CRC-16 over all bytes above
+    };
+
+    inline uint16_t crc16(const uint8_t* data, size_t length) {
+        uint16_t crc = 0xFFFF;
+        while (length--) crc = _crc16_update(crc, *data++);
+        return crc;
+    }
+
+    template <typename T>
+    uint16_t recordCrc(const Record<T>& record) {
+        return crc16(reinterpret_cast<const uint8_t*>(&record), offsetof(Record<T>, crc));
+    }
+
+    template <typename T>
+    LoadResult load(int address, uint16_t magic, uint8_t version, T& values) {
+        Record<T> record;
+        EEPROM.get(address, record);
+        if (record.magic != magic) return LoadResult::BLANK;
+        if (record.version != version || record.size != sizeof(T) || record.crc != recordCrc(record)) {
+            return LoadResult::INVALID;
+        }
+        values = record.values;
+        return LoadResult::OK;
+    }
+
+    // Returns the number of bytes the record occupies
+    template <typename T>
+    size_t save(int address, uint16_t magic, uint8_t version, const T& values) {
+        Record<T> record;
+        record.magic = magic;
+        record.version = version;
+        record.size = sizeof(T);
+        record.values = values;
+        record.crc = recordCrc(record);
+        EEPROM.put(address, record);
+        return sizeof(record);
+    }
+}
+
+#endif // EEPROM_STORE_H
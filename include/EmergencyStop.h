@@ -0,0 +1,127 @@
+#ifndef EMERGENCY_STOP_H
+#define EMERGENCY_STOP_H
+
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <TimerThree.h>
+#include "StepperMotor.h"
+#include "Config.h"
+
+enum class EStopSource : uint8_t {
+    NONE,
+    SERIAL_BYTE,    // Reserved byte seen in the RX buffer
+    INPUT_PIN       // External e-stop input
+};
+
+// Read-only access to HardwareSerial's RX ring buffer (protected members).
+// A pointer to member formed through a derived class may be applied to the
+// base object, so no cast of Serial is needed.
+struct SerialRxAccess : public HardwareSerial {
+    static rx_buffer_index_t head(HardwareSerial& port) {
+        return port.*(&SerialRxAccess::_rx_buffer_head);
+    }
+    static unsigned char at(HardwareSerial& port, rx_buffer_index_t index) {
+        return (port.*(&SerialRxAccess::_rx_buffer))[index];
+    }
+};
+
+class EmergencyStop {
+private:
+    StepperMotor& motor1;
+    StepperMotor& motor2;
+
+    volatile EStopSource source;        // Latched fault (NONE = clear)
+    volatile bool reportPending;        // Set in ISR, reported by main loop
+    rx_buffer_index_t scanIndex;        // Next RX buffer slot to inspect
+
+public:
+    EmergencyStop(StepperMotor& m1, StepperMotor& m2)
+        : motor1(m1), motor2(m2),
+          source(EStopSource::NONE), reportPending(false), scanIndex(0) {}
+
+    // Also enables the Timer0 compare A interrupt that polls for the stop
+    // byte (fairfanpio.cpp), halfway between millis() overflows. An input
+    // that is already open latches the fault here: the pin interrupt only
+    // sees the rising edge.
+    void init() {
+        scanIndex = SerialRxAccess::head(Serial);
+        OCR0A = 0x80;
+        TIMSK0 |= _BV(OCIE0A);
+        if (Config::EStop::INPUT_ENABLED) {
+            pinMode(Config::EStop::INPUT_PIN, INPUT_PULLUP);
+            if (isInputActive()) trigger(EStopSource::INPUT_PIN);
+        }
+    }
+
+    // Halt both step ISRs and latch the fault - ISR safe, a few µs
+    void trigger(EStopSource src) {
+        Timer1.stop();
+        Timer3.stop();
+        motor1.disable();
+        motor2.disable();
+        if (source == EStopSource::NONE) source = src;
+        reportPending = true;
+    }
+
+    // Call from interrupt context (Timer0 compare, step ISRs): scans bytes the
+    // USART RX interrupt has queued since the last call. Returns true if the
+    // stop byte was found.
+    bool pollSerial() {
+        rx_buffer_index_t head = SerialRxAccess::head(Serial);
+        while (scanIndex != head) {
+            unsigned char c = SerialRxAccess::at(Serial, scanIndex);
+            scanIndex = (rx_buffer_index_t)((scanIndex + 1) % SERIAL_RX_BUFFER_SIZE);
+            if (c == Config::EStop::SERIAL_BYTE) {
+                trigger(EStopSource::SERIAL_BYTE);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // External input: NC contact to GND, open circuit = stop
+    bool isInputActive() const {
+        return Config::EStop::INPUT_ENABLED && digitalRead(Config::EStop::INPUT_PIN) == HIGH;
+    }
+
+    // Call every loop() pass: latches again if the input is open after a
+    // reset or an edge was missed, so a held-open contact keeps the fault
+    void pollInput() {
+        if (!isLatched() && isInputActive()) trigger(EStopSource::INPUT_PIN);
+    }
+
+    bool isLatched() const {
+        return source != EStopSource::NONE;
+    }
+
+    // Returns true (once) after a trigger, so the main loop can report it
+    bool takeReport() {
+        if (!reportPending) return false;
+        reportPending = false;
+        return true;
+    }
+
+    void printFault() const {
+        Serial.print(F("EMERGENCY STOP ("));
+        Serial.print(source == EStopSource::INPUT_PIN ? F("input") : F("serial Ctrl-X"));
+        Serial.println(F("): All motors halted, fault latched"));
+        Serial.println(F("Send 'reset' to clear, then 'home' before restarting seq1"));
+    }
+
+    // Clear the latch (motors stay disabled; IdlePower restarts a step timer
+    // when its axis next moves)
+    bool reset() {
+        if (isInputActive()) {
+            Serial.println(F("Error: Emergency stop input still active"));
+            return false;
+        }
+        noInterrupts();
+        source = EStopSource::NONE;
+        reportPending = false;
+        interrupts();
+        Serial.println(F("Emergency stop cleared"));
+        return true;
+    }
+};
+
+#endif // EMERGENCY_STOP_H
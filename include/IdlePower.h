@@ -0,0 +1,171 @@
+#ifndef IDLE_POWER_H
+#define IDLE_POWER_H
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <TimerOne.h>
+#include <TimerThree.h>
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "EmergencyStop.h"
+#include "SequenceStateMachine.h"
+#include "Config.h"
+
+// Idle power mode (Config::Power).
+//
+// A step timer only runs while its axis is enabled; otherwise the ISR would
+// fire 8-16k times per second just to take its disabled branch. Motor 2's
+// driver is switched off (ENABLE_PIN HIGH) after DRIVER_OFF_DELAY_MS without
+// a move and switched back on DRIVER_WAKE_US before its timer restarts, so
+// the first pulse always meets the driver's wake time. Motor 1 has no enable
+// pin in this wiring.
+//
+// IdlePower is the only code that starts a step timer. TimerOne/TimerThree
+// setPeriod() writes the clock-select bits and so restarts a stopped timer:
+// speed updates go through setPeriod() here, which only stores the period
+// while the timer is held and applies it when the timer is released. A
+// latched e-stop holds both timers until it is reset and an axis moves.
+//
+// update() runs from loop() and yield(): moves started before a delay()
+// (seq1 starts Motor 2, then waits for DIR settle) get their timer without
+// waiting for the next loop() pass. The serial e-stop does not depend on
+// the step timers: the Timer0 compare interrupt polls for it.
+
+class IdlePower {
+private:
+    MainMotor& motor1;
+    OscillationMotor& motor2;
+    EmergencyStop& eStop;
+    SequenceStateMachine& sequence;
+
+    bool timerRunning[2];
+    unsigned long periodUs[2];      // Last requested step timer period
+    bool driverOn;
+    unsigned long wakeStartUs;      // Driver enabled at
+    unsigned long lastMoveMs;       // Motor 2 last seen enabled
+
+    // setPeriod() restarts the clock; start() then zeroes the counter, so
+    // the first ISR comes one full period after the release. The latch is
+    // checked with interrupts off: the Timer0 compare may latch it at any
+    // point before that.
+    void startTimer(uint8_t axis) {
+        noInterrupts();
+        if (!eStop.isLatched()) {
+            if (axis == 0) {
+                Timer1.setPeriod(periodUs[0]);
+                Timer1.start();
+            } else {
+                Timer3.setPeriod(periodUs[1]);
+                Timer3.start();
+            }
+            timerRunning[axis] = true;
+        }
+        interrupts();
+    }
+
+public:
+    IdlePower(MainMotor& m1, OscillationMotor& m2, EmergencyStop& es, SequenceStateMachine& seq)
+        : motor1(m1), motor2(m2), eStop(es), sequence(seq), timerRunning{ false, false }, periodUs{ 0, 0 },
+          driverOn(false), wakeStartUs(0), lastMoveMs(0) {}
+
+    // Call after the step timers are initialised: holds both until their
+    // axis moves, and the first Motor 2 move waits out the driver wake time
+    void init() {
+        Timer1.stop();
+        Timer3.stop();
+        periodUs[0] = motor1.getTimerPeriod();
+        periodUs[1] = motor2.getTimerPeriod();
+        pinMode(Config::Motor2::ENABLE_PIN, OUTPUT);
+        digitalWrite(Config::Motor2::ENABLE_PIN, LOW);
+        driverOn = true;
+        wakeStartUs = micros();
+        lastMoveMs = millis();
+    }
+
+    // Step timer period (axis 0 = Motor 1 / Timer1, 1 = Motor 2 / Timer3)
+    void setPeriod(uint8_t axis, unsigned long us) {
+        periodUs[axis] = us;
+        noInterrupts();
+        if (timerRunning[axis] && !eStop.isLatched()) {         // Else applied by startTimer()
+            if (axis == 0) {
+                Timer1.setPeriod(us);
+            } else {
+                Timer3.setPeriod(us);
+            }
+        }
+        interrupts();
+    }
+
+    void update() {
+        // trigger() stopped both timers, but a startTimer() or setPeriod()
+        // that raced the latch may have restarted one: stop them again
+        if (eStop.isLatched()) {
+            noInterrupts();
+            Timer1.stop();
+            Timer3.stop();
+            timerRunning[0] = timerRunning[1] = false;
+            interrupts();
+            return;
+        }
+
+        // Stopped only once the ISR has dropped a cut-off pulse
+        if (motor1.isEnabled()) {
+            if (!timerRunning[0]) startTimer(0);
+        } else if (Config::Power::STOP_IDLE_TIMERS && !motor1.isPulseHigh()) {
+            Timer1.stop();
+            timerRunning[0] = false;
+        }
+
+        if (motor2.isEnabled() || sequence.isPaused()) {
+            lastMoveMs = millis();
+        }
+        if (motor2.isEnabled()) {
+            if (!driverOn) {
+                digitalWrite(Config::Motor2::ENABLE_PIN, LOW);
+                driverOn = true;
+                wakeStartUs = micros();
+            }
+            if (!timerRunning[1] && micros() - wakeStartUs >= Config::Power::DRIVER_WAKE_US) {
+                startTimer(1);
+            }
+        } else {
+            bool driverOff = driverOn && Config::Power::DRIVER_OFF_DELAY_MS > 0 &&
+                             millis() - lastMoveMs >= Config::Power::DRIVER_OFF_DELAY_MS;
+            if (driverOff) {
+                digitalWrite(Config::Motor2::ENABLE_PIN, HIGH);
+                driverOn = false;
+            }
+            // Also stopped with the driver off, so no pulse beats the wake time
+            if ((Config::Power::STOP_IDLE_TIMERS || !driverOn) && !motor2.isPulseHigh()) {
+                Timer3.stop();
+                timerRunning[1] = false;
+            }
+        }
+    }
+
+    bool timersStopped() const {
+        return !timerRunning[0] && !timerRunning[1];
+    }
+
+    bool isDriverOn() const { return driverOn; }
+
+    // delay() replacement for loop(): idle sleep while both timers are
+    // stopped. Any interrupt wakes the CPU (Timer0 millis tick every
+    // 1.024 ms, USART RX, e-stop input) and yield() runs after each wake.
+    void wait(unsigned long ms) {
+        unsigned long start = millis();
+        while (millis() - start < ms) {
+            if (!Config::Power::IDLE_SLEEP || !timersStopped()) {
+                delay(ms - (millis() - start));
+                return;
+            }
+            set_sleep_mode(SLEEP_MODE_IDLE);
+            sleep_enable();
+            sleep_cpu();
+            sleep_disable();
+            yield();
+        }
+    }
+};
+
+#endif // IDLE_POWER_H
@@ -1,44 +1,46 @@
 #ifndef MAIN_MOTOR_H
 #define MAIN_MOTOR_H
 
-#include "StepperMotor.h"
+#include "ProfiledMotor.h"
 #include "Config.h"
 
-class MainMotor : public StepperMotor {
-private:
-    // Speed profile variables
-    float currentSpeedFactor;
-    unsigned long accelEndStep;
-    unsigned long decelStartStep;
-    const unsigned long accelZoneSteps;   // Pre-calculated accel zone (based on 360°)
-    const unsigned long decelZoneSteps;   // Pre-calculated decel zone (based on 360°)
-    
-    // Calculate acceleration/deceleration factors
-    float getAccelFactor(unsigned long currentStep) const {
-        if (accelEndStep == 0) return 1.0f;
-        float progress = (float)currentStep / (float)accelEndStep;
-        float factor = pow(progress, Config::Motor1::POWER_CURVE);
-        return max(factor, Config::Motor1::MIN_SPEED_FACTOR);
+// Compile-time profile descriptor for Motor 1 (see SpeedProfile.h)
+struct Motor1Profile {
+    static constexpr Config::ProfileShape SHAPE = Config::Motor1::PROFILE_SHAPE;
+    static constexpr unsigned long STEPS_PER_ROTATION =
+        (unsigned long)Config::Motor1::GEAR_RATIO * Config::Motor1::STEPS_PER_REV * Config::Motor1::MICROSTEPS;
+    static constexpr float JERK_FRACTION = Config::Motor1::S_CURVE_JERK;
+
+    static constexpr SpeedProfileParams defaults() {
+        return { Config::Motor1::ACCEL_ZONE, Config::Motor1::DECEL_ZONE,
+                 Config::Motor1::POWER_CURVE, Config::Motor1::MIN_SPEED_FACTOR };
     }
+};
+
+class MainMotor : public ProfiledMotor<Motor1Profile> {
+private:
+    // Velocity (jog) mode
+    volatile bool jogging;          // step() runs the velocity path
+    volatile bool jogPaused;        // No new pulses (below JOG_MIN_RPM or reversing)
+    bool jogForward;                // Direction currently on DIR pin (true = CW/RIGHT)
+    bool jogStopping;               // Disable once the ramp is below JOG_MIN_RPM
+    float jogVelocity;              // Signed RPM, ramped toward jogTarget
+    float jogTarget;
+    unsigned long lastJogMicros;
+    unsigned long lastJogMillis;
     
-    float getDecelFactor(unsigned long currentStep) const {
-        if (currentStep <= decelStartStep) return 1.0f;
-        unsigned long remainingSteps = totalSteps - currentStep;
-        unsigned long decelSteps = totalSteps - decelStartStep;
-        if (decelSteps == 0) return 1.0f;
-        float progress = (float)remainingSteps / (float)decelSteps;
-        float factor = pow(progress, Config::Motor1::POWER_CURVE);
-        return max(factor, Config::Motor1::MIN_SPEED_FACTOR);
+    float jogMinFactor() const {
+        return Config::Motor1::JOG_MIN_RPM / targetRPM;
     }
     
 public:
     MainMotor() 
-        : StepperMotor(Config::Motor1::STEP_PIN, Config::Motor1::DIR_PIN,
-                       Config::Motor1::STEPS_PER_REV, Config::Motor1::MICROSTEPS,
-                       Config::Motor1::GEAR_RATIO, Config::Motor1::TARGET_RPM),
-          currentSpeedFactor(1.0f), accelEndStep(0), decelStartStep(0),
-          accelZoneSteps((unsigned long)(Config::Motor1::GEAR_RATIO * Config::Motor1::STEPS_PER_REV * Config::Motor1::MICROSTEPS * Config::Motor1::ACCEL_ZONE)),
-          decelZoneSteps((unsigned long)(Config::Motor1::GEAR_RATIO * Config::Motor1::STEPS_PER_REV * Config::Motor1::MICROSTEPS * Config::Motor1::DECEL_ZONE)) {}
+        : ProfiledMotor(Config::Motor1::STEP_PIN, Config::Motor1::DIR_PIN,
+                        Config::Motor1::STEPS_PER_REV, Config::Motor1::MICROSTEPS,
+                        Config::Motor1::GEAR_RATIO, Config::Motor1::TARGET_RPM,
+                        Config::Motor1::PROFILE_UPDATE_STEPS),
+          jogging(false), jogPaused(false), jogForward(true), jogStopping(false),
+          jogVelocity(0.0f), jogTarget(0.0f), lastJogMicros(0), lastJogMillis(0) {}
     
     // Calculate total steps for given degrees
     unsigned long calculateSteps(float degrees) const {
@@ -55,38 +57,116 @@ public:
             degrees = Config::Motor1::MAX_DEGREES;
         }
         
-        totalSteps = calculateSteps(degrees);
-        
-        // Use pre-calculated accel/decel zones (relative to 360°)
-        // This keeps acceleration consistent regardless of movement distance
-        accelEndStep = accelZoneSteps;
-        decelStartStep = (totalSteps > decelZoneSteps) ? (totalSteps - decelZoneSteps) : 0;
+        jogging = false;
+        beginMove(calculateSteps(degrees));
+    }
+    
+    // ISR callback. Position moves use the base class; in velocity mode the
+    // step count never ends the move and no pulse starts while paused.
+    bool step() override {
+        if (!jogging) return StepperMotor::step();
+        if (!enabled) {
+            finishCutPulse();
+            return false;
+        }
+        if (stepLevel) {
+            stepLevel = false;
+            digitalWrite(stepPin, LOW);
+            stepCount++;
+            return true;
+        }
+        if (!jogPaused) {
+            stepLevel = true;
+            digitalWrite(stepPin, HIGH);
+        }
+        return false;
+    }
+    
+    // === Velocity (jog) mode ===
+    
+    // Start or retarget continuous rotation (negative = CCW/LEFT). The
+    // speed ramps at JOG_ACCEL_RPM_PER_S, through zero on a reversal.
+    // Non-zero targets are clamped to at least JOG_MIN_RPM so they pulse.
+    void setTargetVelocity(float rpm) {
+        if (rpm > Config::Motor1::MAX_RPM) rpm = Config::Motor1::MAX_RPM;
+        if (rpm < -Config::Motor1::MAX_RPM) rpm = -Config::Motor1::MAX_RPM;
+        if (rpm > 0.0f && rpm < Config::Motor1::JOG_MIN_RPM) rpm = Config::Motor1::JOG_MIN_RPM;
+        if (rpm < 0.0f && rpm > -Config::Motor1::JOG_MIN_RPM) rpm = -Config::Motor1::JOG_MIN_RPM;
+        jogTarget = rpm;
+        jogStopping = false;
+        if (isJogging()) return;
         
-        stepCount = 0;
-        currentSpeedFactor = Config::Motor1::MIN_SPEED_FACTOR; // Start at minimum speed
+        // Motor is stopped here, so DIR can change right away
+        jogVelocity = 0.0f;
+        jogForward = rpm >= 0.0f;
+        setDirection(jogForward ? Config::CW_RIGHT : Config::CCW_LEFT);
+        jogPaused = true;
+        stepLevel = false;
+        profileUpdateDue = false;
+        lastJogMicros = micros();
+        lastJogMillis = millis() - Config::Motor1::JOG_UPDATE_MS;   // First update right away
+        currentSpeedFactor = jogMinFactor();
+        jogging = true;
         enabled = true;
     }
     
-    // Update speed profile (call from main loop)
-    float updateSpeedProfile() {
-        if (!enabled) return 1.0f;
-        
-        unsigned long currentStep = stepCount;
-        float accelFactor = getAccelFactor(currentStep);
-        float decelFactor = getDecelFactor(currentStep);
-        currentSpeedFactor = min(accelFactor, decelFactor);
-        
-        return currentSpeedFactor;
+    // Ramp down at the jog rate, then disable
+    void stopVelocity() {
+        jogTarget = 0.0f;
+        jogStopping = true;
     }
     
-    // Get current speed factor
-    float getSpeedFactor() const {
-        return currentSpeedFactor;
+    bool isJogging() const { return jogging && enabled; }
+    float getVelocity() const { return jogVelocity; }
+    float getTargetVelocity() const { return jogTarget; }
+    
+    // Returns true every JOG_UPDATE_MS while jogging. Velocity updates are
+    // paced by time, not by steps: near zero there are no steps.
+    bool takeVelocityUpdateRequest() {
+        if (!isJogging()) return false;
+        unsigned long now = millis();
+        if (now - lastJogMillis < Config::Motor1::JOG_UPDATE_MS) return false;
+        lastJogMillis = now;
+        return true;
     }
     
-    // Check if movement complete
-    bool isMovementComplete() const {
-        return !enabled && stepCount >= totalSteps;
+    // Advance the velocity ramp; returns the speed factor for the timer
+    // period like updateSpeedProfile(). The timer keeps running throughout:
+    // below JOG_MIN_RPM the ISR just sends no pulses. DIR only changes once
+    // the ISR has parked the step pin, and pulses resume one update interval
+    // later at the earliest (driver setup time).
+    float updateVelocity() {
+        unsigned long now = micros();
+        float maxChange = Config::Motor1::JOG_ACCEL_RPM_PER_S * (float)(now - lastJogMicros) * 1e-6f;
+        lastJogMicros = now;
+        
+        float change = jogTarget - jogVelocity;
+        if (change > maxChange) change = maxChange;
+        if (change < -maxChange) change = -maxChange;
+        jogVelocity += change;
+        
+        float speed = fabs(jogVelocity);
+        bool forward = (jogVelocity != 0.0f) ? (jogVelocity > 0.0f) : jogForward;
+        
+        if (forward != jogForward && jogPaused && !stepLevel) {
+            setDirection(forward ? Config::CW_RIGHT : Config::CCW_LEFT);
+            jogForward = forward;
+            currentSpeedFactor = jogMinFactor();
+            return currentSpeedFactor;
+        }
+        if (speed < Config::Motor1::JOG_MIN_RPM || forward != jogForward) {
+            if (jogStopping) {
+                enabled = false;
+                jogging = false;
+                jogVelocity = 0.0f;
+            }
+            jogPaused = true;
+            currentSpeedFactor = jogMinFactor();
+            return currentSpeedFactor;
+        }
+        jogPaused = false;
+        currentSpeedFactor = speed / targetRPM;
+        return currentSpeedFactor;
     }
 };
 
@@ -0,0 +1,135 @@
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <Arduino.h>
+
+// RAM usage instrumentation for the 8 KB ATmega2560.
+//
+// At boot (before constructors run) everything between the end of .bss and
+// the top of RAM is painted with a canary byte. The deepest the stack (or
+// the heap) has ever reached is then found by scanning for the first
+// overwritten byte.
+
+namespace MemoryMonitorConfig {
+    constexpr uint8_t STACK_CANARY = 0xC5;
+}
+
+#if defined(__AVR__)
+
+extern uint8_t __data_start;
+extern uint8_t __data_end;
+extern uint8_t __bss_start;
+extern uint8_t __bss_end;
+extern uint8_t __heap_start;
+extern uint8_t _end;
+extern uint8_t __stack;
+extern char* __brkval;
+extern size_t __malloc_margin;
+
+// avr-libc malloc free list (see avr-libc malloc.c)
+struct __freelist {
+    size_t sz;
+    struct __freelist* nx;
+};
+extern struct __freelist* __flp;
+
+// Paint RAM between .bss and RAMEND. Runs in .init3: SP is set up but no
+// stack is in use yet and nothing has been allocated.
+static void paintStack() __attribute__((naked, used, section(".init3")));
+static void paintStack() {
+    __asm volatile(
+        "    ldi r30, lo8(_end)      \n"
+        "    ldi r31, hi8(_end)      \n"
+        "    ldi r24, %0             \n"
+        "    ldi r25, hi8(__stack)   \n"
+        "    rjmp 2f                 \n"
+        "1:  st Z+, r24              \n"
+        "2:  cpi r30, lo8(__stack)   \n"
+        "    cpc r31, r25            \n"
+        "    brlo 1b                 \n"
+        "    breq 1b                 \n"
+        :: "M"(MemoryMonitorConfig::STACK_CANARY));
+}
+
+#endif
+
+class MemoryMonitor {
+public:
+    struct Report {
+        uint16_t staticRam;       // .data + .bss
+        uint16_t heapUsed;        // Heap break minus heap start
+        uint16_t freeNow;         // Gap between heap break and stack pointer
+        uint16_t freeLowWater;    // Smallest that gap has ever been (unpainted bytes)
+        uint16_t freeListBytes;   // Bytes in freed heap blocks
+        uint8_t freeListBlocks;
+        uint16_t largestBlock;    // Largest allocation malloc() could satisfy now
+        uint8_t fragmentation;    // 100 * (1 - largest / total free), percent
+    };
+
+#if defined(__AVR__)
+    static Report measure() {
+        Report r;
+        uint8_t* heapTop = __brkval ? (uint8_t*)__brkval : &__heap_start;
+        uint8_t* sp = (uint8_t*)SP;
+
+        r.staticRam = (uint16_t)((&__data_end - &__data_start) + (&__bss_end - &__bss_start));
+        r.heapUsed = (uint16_t)(heapTop - &__heap_start);
+        r.freeNow = (uint16_t)(sp - heapTop);
+
+        // Untouched canary bytes above the heap break = stack low-water mark
+        uint8_t* p = heapTop;
+        while (p < sp && *p == MemoryMonitorConfig::STACK_CANARY) p++;
+        r.freeLowWater = (uint16_t)(p - heapTop);
+
+        r.freeListBytes = 0;
+        r.freeListBlocks = 0;
+        uint16_t largestFreed = 0;
+        for (struct __freelist* fp = __flp; fp; fp = fp->nx) {
+            r.freeListBytes += fp->sz;
+            r.freeListBlocks++;
+            if (fp->sz > largestFreed) largestFreed = fp->sz;
+        }
+
+        // malloc() can also extend the break up to __malloc_margin below SP
+        uint16_t gap = (r.freeNow > __malloc_margin) ? (uint16_t)(r.freeNow - __malloc_margin) : 0;
+        r.largestBlock = max(largestFreed, gap);
+
+        uint16_t totalFree = r.freeListBytes + gap;
+        r.fragmentation = totalFree ? (uint8_t)(100UL - (100UL * r.largestBlock) / totalFree) : 0;
+        return r;
+    }
+#else
+    // Host builds have no canary or AVR heap to inspect
+    static Report measure() {
+        Report r = {};
+        return r;
+    }
+#endif
+
+    static void printReport() {
+        Report r = measure();
+        Serial.println(F("=== Memory ==="));
+        Serial.print(F("Static RAM (.data+.bss): "));
+        Serial.print(r.staticRam);
+        Serial.println(F(" bytes"));
+        Serial.print(F("Free now: "));
+        Serial.print(r.freeNow);
+        Serial.print(F(" bytes, low-water: "));
+        Serial.print(r.freeLowWater);
+        Serial.println(F(" bytes"));
+        Serial.print(F("Heap used: "));
+        Serial.print(r.heapUsed);
+        Serial.print(F(" bytes, free list: "));
+        Serial.print(r.freeListBytes);
+        Serial.print(F(" bytes in "));
+        Serial.print(r.freeListBlocks);
+        Serial.println(F(" blocks"));
+        Serial.print(F("Largest free block: "));
+        Serial.print(r.largestBlock);
+        Serial.print(F(" bytes, fragmentation: "));
+        Serial.print(r.fragmentation);
+        Serial.println(F("%"));
+    }
+};
+
+#endif // MEMORY_MONITOR_H
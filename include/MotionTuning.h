@@ -0,0 +1,264 @@
+#ifndef MOTION_TUNING_H
+#define MOTION_TUNING_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "EepromStore.h"
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "Config.h"
+
+// Runtime-tunable motion parameters (defaults from Config::Motor1/Motor2).
+//
+// 'set' only stages a value. loop() swaps the whole staged set into the
+// motors while no axis is moving (also between seq1 half-cycles), so a move
+// never runs with half-updated parameters. Derived values (step frequency,
+// ramp zone steps, offset steps) are recomputed once at the swap. A changed
+// m2.offset also waits for seq1 and homing to be idle and invalidates
+// homing, because the swept range depends on it; an offset that leaves no
+// sweep in the last homed range is refused (homing re-checks it).
+//
+// 'save' writes the staged set as an EepromStore record; init() loads it
+// back only if magic, layout version, size and CRC all match.
+
+struct AxisTuning {
+    float targetRpm;
+    SpeedProfileParams profile;
+};
+
+struct TuningValues {
+    AxisTuning motor1;
+    AxisTuning motor2;
+    float offsetDegrees;        // Motor2 offset from the right switch after homing
+};
+
+class MotionTuning {
+public:
+    struct Field {
+        const char* name;       // PROGMEM
+        uint8_t offset;         // Byte offset of the float in TuningValues
+        float minValue;
+        float maxValue;
+    };
+
+private:
+    MainMotor& motor1;
+    OscillationMotor& motor2;
+    TuningValues active;        // What the motors are running with
+    TuningValues staged;        // Edited by 'set', swapped in between moves
+    bool pending;
+
+    static constexpr uint8_t FIELD_COUNT = 11;
+
+    // Names and limits live in flash; copies entry 'index' into RAM
+    static void fieldAt(uint8_t index, Field& out) {
+        static const char m1Rpm[] PROGMEM    = "m1.rpm";
+        static const char m1Accel[] PROGMEM  = "m1.accel";
+        static const char m1Decel[] PROGMEM  = "m1.decel";
+        static const char m1Power[] PROGMEM  = "m1.power";
+        static const char m1Min[] PROGMEM    = "m1.min";
+        static const char m2Rpm[] PROGMEM    = "m2.rpm";
+        static const char m2Accel[] PROGMEM  = "m2.accel";
+        static const char m2Decel[] PROGMEM  = "m2.decel";
+        static const char m2Power[] PROGMEM  = "m2.power";
+        static const char m2Min[] PROGMEM    = "m2.min";
+        static const char m2Offset[] PROGMEM = "m2.offset";
+        static const Field table[] PROGMEM = {
+            { m1Rpm,    offsetof(TuningValues, motor1.targetRpm),              Config::Tuning::MIN_RPM,  Config::Motor1::MAX_RPM },
+            { m1Accel,  offsetof(TuningValues, motor1.profile.accelZone),      Config::Tuning::MIN_ZONE, 1.0f },
+            { m1Decel,  offsetof(TuningValues, motor1.profile.decelZone),      Config::Tuning::MIN_ZONE, 1.0f },
+            { m1Power,  offsetof(TuningValues, motor1.profile.powerCurve),     0.1f,  4.0f },
+            { m1Min,    offsetof(TuningValues, motor1.profile.minSpeedFactor), 0.01f, 1.0f },
+            { m2Rpm,    offsetof(TuningValues, motor2.targetRpm),              Config::Tuning::MIN_RPM,  Config::Motor2::MAX_RPM },
+            { m2Accel,  offsetof(TuningValues, motor2.profile.accelZone),      Config::Tuning::MIN_ZONE, 1.0f },
+            { m2Decel,  offsetof(TuningValues, motor2.profile.decelZone),      Config::Tuning::MIN_ZONE, 1.0f },
+            { m2Power,  offsetof(TuningValues, motor2.profile.powerCurve),     0.1f,  4.0f },
+            { m2Min,    offsetof(TuningValues, motor2.profile.minSpeedFactor), 0.01f, 1.0f },
+            { m2Offset, offsetof(TuningValues, offsetDegrees),                 0.0f,  Config::Tuning::MAX_OFFSET_DEGREES },
+        };
+        static_assert(sizeof(table) / sizeof(table[0]) == FIELD_COUNT, "FIELD_COUNT out of date");
+        memcpy_P(&out, &table[index], sizeof(Field));
+    }
+
+    static const __FlashStringHelper* nameOf(const Field& field) {
+        return reinterpret_cast<const __FlashStringHelper*>(field.name);
+    }
+
+    // Returns false if no field has this name
+    static bool find(const String& name, Field& out) {
+        for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+            fieldAt(i, out);
+            if (strcmp_P(name.c_str(), out.name) == 0) return true;
+        }
+        return false;
+    }
+
+    static float& valueOf(TuningValues& values, const Field& field) {
+        return *reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(&values) + field.offset);
+    }
+
+    static bool inRange(const Field& field, float value) {
+        return value >= field.minValue && value <= field.maxValue;   // Also rejects NaN
+    }
+
+    static bool isValid(TuningValues& values) {
+        Field field;
+        for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+            fieldAt(i, field);
+            if (!inRange(field, valueOf(values, field))) return false;
+        }
+        return true;
+    }
+
+    bool differs() const {
+        return memcmp(&staged, &active, sizeof(TuningValues)) != 0;
+    }
+
+    // Recompute derived values from the staged set (motors must be stopped)
+    void applyToMotors() {
+        motor1.setTargetRPM(staged.motor1.targetRpm);
+        motor1.setProfileParams(staged.motor1.profile);
+        motor2.setTargetRPM(staged.motor2.targetRpm);
+        motor2.setProfileParams(staged.motor2.profile);
+        if (staged.offsetDegrees != active.offsetDegrees) {
+            motor2.setOffsetDegrees(staged.offsetDegrees);
+            motor2.invalidateHoming();
+        }
+        active = staged;
+        pending = false;
+    }
+
+    void printField(const Field& field) {
+        Serial.print(nameOf(field));
+        Serial.print(F(" = "));
+        Serial.print(valueOf(active, field), 3);
+        float next = valueOf(staged, field);
+        if (next != valueOf(active, field)) {
+            Serial.print(F(" (pending "));
+            Serial.print(next, 3);
+            Serial.print(F(")"));
+        }
+        Serial.println();
+    }
+
+public:
+    MotionTuning(MainMotor& m1, OscillationMotor& m2)
+        : motor1(m1), motor2(m2), active(defaults()), staged(active), pending(false) {}
+
+    static TuningValues defaults() {
+        return {
+            { Config::Motor1::TARGET_RPM, Motor1Profile::defaults() },
+            { Config::Motor2::TARGET_RPM, Motor2Profile::defaults() },
+            Config::Motor2::OFFSET_DEGREES
+        };
+    }
+
+    // Call after the motors' init(): replaces the defaults with saved values
+    void init() {
+        TuningValues saved;
+        EepromStore::LoadResult result = EepromStore::load(Config::Tuning::EEPROM_ADDRESS, Config::Tuning::EEPROM_MAGIC,
+                                                           Config::Tuning::EEPROM_VERSION, saved);
+        if (result == EepromStore::LoadResult::BLANK) return;     // Never saved
+
+        if (result != EepromStore::LoadResult::OK || !isValid(saved)) {
+            Serial.println(F("Tuning: EEPROM block invalid (version/CRC) - using defaults"));
+            return;
+        }
+        staged = saved;
+        applyToMotors();
+        Serial.println(F("Tuning: loaded from EEPROM"));
+    }
+
+    // Stage one value; applied by applyPending()
+    bool set(const String& name, float value) {
+        Field field;
+        if (!find(name, field)) {
+            Serial.print(F("Error: Unknown parameter '"));
+            Serial.print(name);
+            Serial.println(F("' - send 'get' for the list"));
+            return false;
+        }
+        if (!inRange(field, value)) {
+            Serial.print(F("Error: "));
+            Serial.print(nameOf(field));
+            Serial.print(F(" must be between "));
+            Serial.print(field.minValue, 3);
+            Serial.print(F(" and "));
+            Serial.println(field.maxValue, 3);
+            return false;
+        }
+        if (field.offset == offsetof(TuningValues, offsetDegrees) &&
+            !motor2.offsetFitsRange(motor2.offsetStepsFor(value))) {
+            motor2.printOffsetError(motor2.offsetStepsFor(value));
+            return false;
+        }
+        valueOf(staged, field) = value;
+        pending = differs();
+        printField(field);
+        return true;
+    }
+
+    bool print(const String& name) {
+        Field field;
+        if (!find(name, field)) {
+            Serial.print(F("Error: Unknown parameter '"));
+            Serial.print(name);
+            Serial.println(F("'"));
+            return false;
+        }
+        printField(field);
+        return true;
+    }
+
+    void printAll() {
+        Field field;
+        for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+            fieldAt(i, field);
+            printField(field);
+        }
+        if (pending) {
+            Serial.println(F("Pending values apply when no axis is moving"));
+        }
+    }
+
+    // Stage the compiled Config values
+    void restoreDefaults() {
+        staged = defaults();
+        pending = differs();
+        Serial.println(F("Tuning: compiled defaults staged - 'save' to keep them"));
+    }
+
+    // Call from loop() before sequence.update(): swaps the staged set in
+    // while both axes are stopped. Returns true when applied.
+    bool applyPending(bool sequenceActive, bool homingActive) {
+        if (!pending || motor1.isEnabled() || motor2.isEnabled()) return false;
+        bool offsetChanged = staged.offsetDegrees != active.offsetDegrees;
+        if (offsetChanged && (sequenceActive || homingActive)) return false;
+
+        applyToMotors();
+        Serial.println(F("Tuning: new parameters applied"));
+        if (offsetChanged) {
+            Serial.println(F("Tuning: Motor2 offset changed - run 'home' before seq1"));
+        }
+        return true;
+    }
+
+    // Write the staged set. EEPROM writes take ~3.3 ms per changed byte and
+    // hold up loop(), so this is refused while an axis is moving.
+    bool save() {
+        if (motor1.isEnabled() || motor2.isEnabled()) {
+            Serial.println(F("Error: Stop all motors before 'save'"));
+            return false;
+        }
+        size_t bytes = EepromStore::save(Config::Tuning::EEPROM_ADDRESS, Config::Tuning::EEPROM_MAGIC,
+                                         Config::Tuning::EEPROM_VERSION, staged);
+        Serial.print(F("Tuning: saved to EEPROM ("));
+        Serial.print((unsigned long)bytes);
+        Serial.println(F(" bytes)"));
+        return true;
+    }
+
+    bool isPending() const { return pending; }
+};
+
+#endif // MOTION_TUNING_H
@@ -1,10 +1,23 @@
 #ifndef OSCILLATION_MOTOR_H
 #define OSCILLATION_MOTOR_H
 
-#include "StepperMotor.h"
+#include "ProfiledMotor.h"
 #include "Config.h"
 #include <Bounce2.h>
 
+// Compile-time profile descriptor for Motor 2 (see SpeedProfile.h)
+struct Motor2Profile {
+    static constexpr Config::ProfileShape SHAPE = Config::Motor2::PROFILE_SHAPE;
+    static constexpr unsigned long STEPS_PER_ROTATION =
+        (unsigned long)Config::Motor2::GEAR_RATIO * Config::Motor2::STEPS_PER_REV * Config::Motor2::MICROSTEPS;
+    static constexpr float JERK_FRACTION = Config::Motor2::S_CURVE_JERK;
+
+    static constexpr SpeedProfileParams defaults() {
+        return { Config::Motor2::ACCEL_ZONE, Config::Motor2::DECEL_ZONE,
+                 Config::Motor2::POWER_CURVE, Config::Motor2::MIN_SPEED_FACTOR };
+    }
+};
+
 enum class HomingState {
     IDLE,
     MOVE_LEFT,
@@ -13,8 +26,11 @@ enum class HomingState {
     COMPLETE
 };
 
-class OscillationMotor : public StepperMotor {
+class OscillationMotor : public ProfiledMotor<Motor2Profile> {
 private:
+    // Steps kept clear of the offset positions on a seq1 sweep
+    static constexpr unsigned long SWEEP_MARGIN_STEPS = 50;
+    
     // Limit switches
     Bounce leftSwitch;
     Bounce rightSwitch;
@@ -24,47 +40,22 @@ private:
     unsigned long homeRangeSteps;
     unsigned long offsetSteps;
     
-    // Speed profile variables
-    float currentSpeedFactor;
-    unsigned long accelEndStep;
-    unsigned long decelStartStep;
+    // Speed profile (off while homing)
     bool speedProfileEnabled;
-    const unsigned long accelZoneSteps;   // Pre-calculated accel zone (based on 360°)
-    const unsigned long decelZoneSteps;   // Pre-calculated decel zone (based on 360°)
     
     // Position tracking
     long currentPosition;
     bool isHomed;
     
-    // Calculate acceleration/deceleration factors
-    float getAccelFactor(unsigned long currentStep) const {
-        if (!speedProfileEnabled || accelEndStep == 0) return 1.0f;
-        float progress = (float)currentStep / (float)accelEndStep;
-        float factor = pow(progress, Config::Motor2::POWER_CURVE);
-        return max(factor, Config::Motor2::MIN_SPEED_FACTOR);
-    }
-    
-    float getDecelFactor(unsigned long currentStep) const {
-        if (!speedProfileEnabled || currentStep <= decelStartStep) return 1.0f;
-        unsigned long remainingSteps = totalSteps - currentStep;
-        unsigned long decelSteps = totalSteps - decelStartStep;
-        if (decelSteps == 0) return 1.0f;
-        float progress = (float)remainingSteps / (float)decelSteps;
-        float factor = pow(progress, Config::Motor2::POWER_CURVE);
-        return max(factor, Config::Motor2::MIN_SPEED_FACTOR);
-    }
-    
 public:
     OscillationMotor() 
-        : StepperMotor(Config::Motor2::STEP_PIN, Config::Motor2::DIR_PIN,
-                       Config::Motor2::STEPS_PER_REV, Config::Motor2::MICROSTEPS,
-                       Config::Motor2::GEAR_RATIO, Config::Motor2::TARGET_RPM),
+        : ProfiledMotor(Config::Motor2::STEP_PIN, Config::Motor2::DIR_PIN,
+                        Config::Motor2::STEPS_PER_REV, Config::Motor2::MICROSTEPS,
+                        Config::Motor2::GEAR_RATIO, Config::Motor2::TARGET_RPM,
+                        Config::Motor2::PROFILE_UPDATE_STEPS),
           leftSwitch(), rightSwitch(),
           homingState(HomingState::IDLE), homeRangeSteps(0), offsetSteps(0),
-          currentSpeedFactor(1.0f), accelEndStep(0), decelStartStep(0),
           speedProfileEnabled(false),
-          accelZoneSteps((unsigned long)(Config::Motor2::GEAR_RATIO * Config::Motor2::STEPS_PER_REV * Config::Motor2::MICROSTEPS * Config::Motor2::ACCEL_ZONE)),
-          decelZoneSteps((unsigned long)(Config::Motor2::GEAR_RATIO * Config::Motor2::STEPS_PER_REV * Config::Motor2::MICROSTEPS * Config::Motor2::DECEL_ZONE)),
           currentPosition(0), isHomed(false) {}
     
     void init() override {
@@ -81,8 +72,34 @@ public:
         rightSwitch.interval(Config::Timing::DEBOUNCE_MS);
         
         // Calculate offset in steps (10 degrees)
-        offsetSteps = (unsigned long)((Config::Motor2::OFFSET_DEGREES / 360.0f) 
-                                      * gearRatio * stepsPerRev * microsteps);
+        setOffsetDegrees(Config::Motor2::OFFSET_DEGREES);
+    }
+    
+    // Offset from the right switch after homing (takes effect at the next homing)
+    void setOffsetDegrees(float degrees) {
+        offsetSteps = offsetStepsFor(degrees);
+    }
+    
+    unsigned long offsetStepsFor(float degrees) const {
+        return (unsigned long)((degrees / 360.0f) * gearRatio * stepsPerRev * microsteps);
+    }
+    
+    // Does a seq1 sweep (range - 2 * offset - margin) stay positive? True
+    // while no range has been measured; homing checks it at the right limit.
+    bool offsetFitsRange(unsigned long steps) const {
+        return homeRangeSteps == 0 || 2 * steps + SWEEP_MARGIN_STEPS < homeRangeSteps;
+    }
+    
+    void printOffsetError(unsigned long steps) const {
+        Serial.print(F("Error: Motor 2 offset "));
+        Serial.print(steps);
+        Serial.print(F(" steps does not fit the range of "));
+        Serial.print(homeRangeSteps);
+        Serial.println(F(" steps - reduce m2.offset"));
+    }
+    
+    unsigned long getHomeRangeSteps() const {
+        return homeRangeSteps;
     }
     
     void updateSwitches() {
@@ -151,6 +168,12 @@ public:
                     Serial.print(F("Homing Motor 2: Right limit reached, Range = "));
                     Serial.print(homeRangeSteps);
                     Serial.println(F(" steps"));
+                    if (!offsetFitsRange(offsetSteps)) {
+                        printOffsetError(offsetSteps);
+                        Serial.println(F("Homing Motor 2: Aborted"));
+                        homingState = HomingState::IDLE;   // Not homed: seq1 refuses to start
+                        break;
+                    }
                     delay(500);
                     resetStepCount(); // Reset for offset movement
                     homingState = HomingState::OFFSET;  // Next: offset back to LEFT
@@ -192,6 +215,10 @@ public:
         }
     }
     
+    bool isSpeedProfileEnabled() const {
+        return speedProfileEnabled;
+    }
+    
     bool isHomingComplete() const {
         return isHomed;
     }
@@ -205,9 +232,21 @@ public:
         isHomed = false;
     }
     
-    // Oscillation control
-    void startOscillation(bool directionRight) {
-        if (!isHomed) return;
+    // Abandon a homing run in progress (e.g. emergency stop)
+    void abortHoming() {
+        enabled = false;
+        homingState = HomingState::IDLE;
+        isHomed = false;
+    }
+    
+    // Oscillation control; false (no move) if not homed or the offset
+    // leaves no sweep in the homed range
+    bool startOscillation(bool directionRight) {
+        if (!isHomed) return false;
+        if (!offsetFitsRange(offsetSteps)) {
+            printOffsetError(offsetSteps);
+            return false;
+        }
         
         // Direction is inverted for this motor: RIGHT=CCW signal, LEFT=CW signal
         setDirection(directionRight ? Config::CCW_LEFT : Config::CW_RIGHT);
@@ -216,36 +255,15 @@ public:
         
         // Calculate safe movement distance (always the full range minus safety margins)
         // Total oscillation range = homeRangeSteps - (2 * offsetSteps) - safety margin
-        totalSteps = homeRangeSteps - (2 * offsetSteps) - 50;
-        
-        // Use pre-calculated accel/decel zones (relative to 360°)
-        // This keeps acceleration consistent regardless of movement distance
-        accelEndStep = accelZoneSteps;
-        decelStartStep = (totalSteps > decelZoneSteps) ? (totalSteps - decelZoneSteps) : 0;
-        
-        resetStepCount();
-        currentSpeedFactor = Config::Motor2::MIN_SPEED_FACTOR;
-        enabled = true;
+        beginMove(homeRangeSteps - (2 * offsetSteps) - SWEEP_MARGIN_STEPS);
+        return true;
     }
     
-    // Update speed profile (call from main loop)
+    // Update speed profile (call when takeProfileUpdateRequest() fires);
+    // constant speed while homing
     float updateSpeedProfile() {
-        if (!speedProfileEnabled || !enabled) return 1.0f;
-        
-        unsigned long currentStep = stepCount;
-        float accelFactor = getAccelFactor(currentStep);
-        float decelFactor = getDecelFactor(currentStep);
-        currentSpeedFactor = min(accelFactor, decelFactor);
-        
-        return currentSpeedFactor;
-    }
-    
-    float getSpeedFactor() const {
-        return currentSpeedFactor;
-    }
-    
-    bool isMovementComplete() const {
-        return !enabled && stepCount >= totalSteps;
+        if (!speedProfileEnabled) return 1.0f;
+        return ProfiledMotor::updateSpeedProfile();
     }
     
     long getPosition() const {
@@ -0,0 +1,96 @@
+#ifndef PROFILED_MOTOR_H
+#define PROFILED_MOTOR_H
+
+#include "StepperMotor.h"
+#include "SpeedProfile.h"
+
+// Stepper running position moves along a SpeedProfile (base of MainMotor and
+// OscillationMotor). Profile is the axis' compile-time descriptor.
+template <typename Profile>
+class ProfiledMotor : public StepperMotor {
+protected:
+    SpeedProfile<Profile> profile;
+    float currentSpeedFactor;
+
+    // Plan a move and start it at minimum speed (direction already set)
+    void beginMove(unsigned long steps) {
+        totalSteps = steps;
+        profile.begin(totalSteps);
+
+        resetStepCount();
+        currentSpeedFactor = profile.getMinSpeedFactor();
+        enabled = true;
+    }
+
+public:
+    ProfiledMotor(uint8_t step, uint8_t dir,
+                  uint16_t spr, uint8_t ms, uint8_t gr, float rpm, uint8_t updateSteps)
+        : StepperMotor(step, dir, spr, ms, gr, rpm, updateSteps),
+          profile(), currentSpeedFactor(1.0f) {}
+
+    // Update speed profile (call when takeProfileUpdateRequest() fires)
+    float updateSpeedProfile() {
+        if (!enabled) return 1.0f;
+
+        currentSpeedFactor = profile.factorAt(stepCount);
+        return currentSpeedFactor;
+    }
+
+    float getSpeedFactor() const {
+        return currentSpeedFactor;
+    }
+
+    const SpeedProfile<Profile>& getProfile() const {
+        return profile;
+    }
+
+    // Change the ramp shape (call between moves: the next move uses it)
+    void setProfileParams(const SpeedProfileParams& params) {
+        profile.setParams(params);
+    }
+
+    // Pause mid-move: brake along the profile to a standstill and keep the
+    // rest of the move for resumeMovement()
+    void pauseMovement() {
+        if (!enabled) return;
+        noInterrupts();
+        unsigned long currentStep = stepCount;
+        interrupts();
+        unsigned long stopStep = profile.hold(currentStep, currentSpeedFactor);
+        noInterrupts();
+        if (stopStep > stepCount) {
+            totalSteps = stopStep;
+        } else if (stepLevel) {
+            totalSteps = stepCount + 1;     // Let the pulse in progress complete
+        } else {
+            totalSteps = stepCount;         // Already there: never past the planned end
+        }
+        interrupts();
+        profileUpdateDue = true;
+    }
+
+    // Re-accelerate and complete a paused move (also valid while still braking)
+    void resumeMovement() {
+        noInterrupts();
+        unsigned long currentStep = stepCount;
+        interrupts();
+        if (currentStep >= profile.getTotalSteps()) return;   // Move had already finished
+        profile.release(currentStep, enabled ? currentSpeedFactor : profile.getMinSpeedFactor());
+        noInterrupts();
+        totalSteps = profile.getTotalSteps();
+        if (!enabled) {
+            stepsUntilUpdate = profileUpdateSteps;
+            currentSpeedFactor = profile.getMinSpeedFactor();
+            enabled = true;
+        }
+        profileUpdateDue = true;
+        interrupts();
+    }
+
+    // Check if movement complete
+    bool isMovementComplete() const {
+        return !enabled && stepCount >= totalSteps;
+    }
+};
+
+#endif // PROFILED_MOTOR_H
@@ -0,0 +1,238 @@
+#ifndef SEQUENCE_PERF_H
+#define SEQUENCE_PERF_H
+
+#include <Arduino.h>
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "EepromStore.h"
+#include "Config.h"
+
+// Throughput and health counters for seq1 (owned by SequenceStateMachine).
+//
+// Each half-cycle is split into time with both motors moving, time waiting
+// for the slower motor and direction-settle time at the reversal. Pauses
+// are counted on their own and excluded from the other three. Time at
+// minimum speed is sampled once per loop() pass. Homing runs are timed
+// from the outside by watching Motor 2's homing state.
+
+// Elapsed time as seconds + milliseconds: no wrap within the unit's life
+struct PerfTime {
+    uint32_t sec;
+    uint16_t msec;
+
+    void add(unsigned long ms) {
+        unsigned long total = msec + ms % 1000;
+        sec += ms / 1000 + total / 1000;
+        msec = (uint16_t)(total % 1000);
+    }
+
+    float seconds() const {
+        return sec + msec / 1000.0f;
+    }
+
+    void print() const {
+        Serial.print(sec);
+        Serial.print('.');
+        Serial.print(msec / 100);
+        Serial.print(F(" s"));
+    }
+};
+
+struct SequenceCounters {
+    uint32_t halfCycles;        // Completed sweeps (one direction each)
+    uint32_t slowerMotor1;      // Half-cycles where Motor 1 finished last
+    uint32_t slowerMotor2;      // Half-cycles where Motor 2 finished last
+    uint16_t homingRuns;        // Completed homing runs
+    uint16_t homingAborts;      // Homing runs that ended without a result
+    PerfTime active;            // seq1 running, pauses included
+    PerfTime moving;            // Both motors moving
+    PerfTime waiting;           // One motor done, waiting for the other
+    PerfTime settle;            // Direction change delays at start/reversal
+    PerfTime paused;
+    PerfTime homing;            // Sum of completed homing runs
+    PerfTime minSpeed[2];       // Motor running at its minimum speed factor
+};
+
+class SequencePerf {
+private:
+    MainMotor& motor1;
+    OscillationMotor& motor2;
+    SequenceCounters counters;
+
+    unsigned long lastSampleMs;
+    unsigned long sweepStartMs;     // Both motors started
+    unsigned long firstDoneMs;      // First motor finished its sweep
+    unsigned long pauseStartMs;
+    unsigned long homingStartMs;
+    unsigned long lastSaveMs;
+    bool sweepRunning;
+    bool firstDone;
+    int8_t slowerMotor;             // 0 = Motor 1, 1 = Motor 2, -1 = finished together
+    bool homingSeen;
+
+    static bool atMinSpeed(float speedFactor, float minSpeedFactor) {
+        return speedFactor <= minSpeedFactor * 1.001f;
+    }
+
+public:
+    SequencePerf(MainMotor& m1, OscillationMotor& m2)
+        : motor1(m1), motor2(m2), counters(),
+          lastSampleMs(0), sweepStartMs(0), firstDoneMs(0), pauseStartMs(0),
+          homingStartMs(0), lastSaveMs(0),
+          sweepRunning(false), firstDone(false), slowerMotor(-1), homingSeen(false) {}
+
+    // Restore counters saved by an earlier run (silent if never saved)
+    void init() {
+        EepromStore::LoadResult result = EepromStore::load(Config::Perf::EEPROM_ADDRESS, Config::Perf::EEPROM_MAGIC,
+                                                           Config::Perf::EEPROM_VERSION, counters);
+        if (result == EepromStore::LoadResult::OK) {
+            Serial.println(F("Perf: counters restored from EEPROM"));
+        } else if (result == EepromStore::LoadResult::INVALID) {
+            Serial.println(F("Perf: EEPROM record invalid - counters start at zero"));
+        }
+        lastSampleMs = lastSaveMs = millis();
+    }
+
+    // Call once per loop() pass, before the sequence acts on completed moves
+    void sample(bool active, bool paused) {
+        unsigned long now = millis();
+        unsigned long elapsed = now - lastSampleMs;
+        lastSampleMs = now;
+
+        if (active) {
+            counters.active.add(elapsed);
+            if (paused) {
+                counters.paused.add(elapsed);
+            } else {
+                if (motor1.isEnabled() && atMinSpeed(motor1.getSpeedFactor(), motor1.getProfile().getMinSpeedFactor())) {
+                    counters.minSpeed[0].add(elapsed);
+                }
+                if (motor2.isEnabled() && atMinSpeed(motor2.getSpeedFactor(), motor2.getProfile().getMinSpeedFactor())) {
+                    counters.minSpeed[1].add(elapsed);
+                }
+                if (sweepRunning && !firstDone) {
+                    bool done1 = motor1.isMovementComplete();
+                    bool done2 = motor2.isMovementComplete();
+                    if (done1 || done2) {
+                        firstDone = true;
+                        firstDoneMs = now;
+                        slowerMotor = (done1 && done2) ? -1 : (done1 ? 1 : 0);
+                    }
+                }
+            }
+        }
+
+        bool homingActive = motor2.getHomingState() != HomingState::IDLE;
+        if (homingActive && !homingSeen) {
+            homingStartMs = now;
+        } else if (!homingActive && homingSeen) {
+            if (motor2.isHomingComplete()) {
+                counters.homingRuns++;
+                counters.homing.add(now - homingStartMs);
+            } else {
+                counters.homingAborts++;
+            }
+        }
+        homingSeen = homingActive;
+
+        // Periodic save only while both motors stand (EEPROM writes block loop())
+        if (Config::Perf::SAVE_INTERVAL_MIN > 0 && !motor1.isEnabled() && !motor2.isEnabled() &&
+            now - lastSaveMs >= Config::Perf::SAVE_INTERVAL_MIN * 60000UL) {
+            save();
+            lastSaveMs = now;
+        }
+    }
+
+    // Sequence events
+    void sweepStarted(unsigned long settleStartMs) {
+        unsigned long now = millis();
+        counters.settle.add(now - settleStartMs);
+        sweepStartMs = now;
+        sweepRunning = true;
+        firstDone = false;
+    }
+
+    void sweepCompleted() {
+        if (!sweepRunning) return;
+        unsigned long now = millis();
+        if (!firstDone) {
+            firstDoneMs = now;
+            slowerMotor = -1;
+        }
+        counters.halfCycles++;
+        counters.moving.add(firstDoneMs - sweepStartMs);
+        counters.waiting.add(now - firstDoneMs);
+        if (slowerMotor == 0) counters.slowerMotor1++;
+        if (slowerMotor == 1) counters.slowerMotor2++;
+        sweepRunning = false;
+    }
+
+    void sweepAborted() {
+        sweepRunning = false;
+    }
+
+    void pauseStarted() {
+        pauseStartMs = millis();
+    }
+
+    // Shift the sweep's timestamps so the pause counts as neither moving nor waiting
+    void pauseEnded() {
+        unsigned long pausedMs = millis() - pauseStartMs;
+        sweepStartMs += pausedMs;
+        if (firstDone) firstDoneMs += pausedMs;     // Paused while waiting
+    }
+
+    void reset() {
+        counters = SequenceCounters();
+        Serial.println(F("Perf: counters cleared"));
+    }
+
+    size_t save() {
+        return EepromStore::save(Config::Perf::EEPROM_ADDRESS, Config::Perf::EEPROM_MAGIC,
+                                 Config::Perf::EEPROM_VERSION, counters);
+    }
+
+    const SequenceCounters& getCounters() const { return counters; }
+
+    void print() const {
+        float running = counters.active.seconds() - counters.paused.seconds();
+
+        Serial.print(F("Perf: "));
+        Serial.print(counters.halfCycles);
+        Serial.print(F(" half-cycles, "));
+        Serial.print(running > 0.0f ? counters.halfCycles * 3600.0f / running : 0.0f, 1);
+        Serial.print(F("/h over "));
+        counters.active.print();
+        Serial.print(F(" active ("));
+        counters.paused.print();
+        Serial.println(F(" paused)"));
+
+        Serial.print(F("  moving "));
+        counters.moving.print();
+        Serial.print(F(", waiting "));
+        counters.waiting.print();
+        Serial.print(F(" (slower: M1 "));
+        Serial.print(counters.slowerMotor1);
+        Serial.print(F("x, M2 "));
+        Serial.print(counters.slowerMotor2);
+        Serial.print(F("x), settle "));
+        counters.settle.print();
+        Serial.println();
+
+        Serial.print(F("  min speed: M1 "));
+        counters.minSpeed[0].print();
+        Serial.print(F(", M2 "));
+        counters.minSpeed[1].print();
+        Serial.println();
+
+        Serial.print(F("  homing: "));
+        Serial.print(counters.homingRuns);
+        Serial.print(F(" runs, "));
+        counters.homing.print();
+        Serial.print(F(", "));
+        Serial.print(counters.homingAborts);
+        Serial.println(F(" aborted"));
+    }
+};
+
+#endif // SEQUENCE_PERF_H
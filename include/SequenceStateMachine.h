@@ -3,6 +3,7 @@
 
 #include "MainMotor.h"
 #include "OscillationMotor.h"
+#include "SequencePerf.h"
 
 class SequenceStateMachine {
 private:
@@ -19,13 +20,31 @@ private:
     State currentState;
     bool motor1SameAsMotor2;
     float motor1Degrees;  // Degrees for Motor1 in sequence (set by start())
+    bool paused;          // Motors braked mid-sweep; state and remaining steps kept
+    bool pauseReported;
+    SequencePerf perf;
     
 public:
     SequenceStateMachine(MainMotor& m1, OscillationMotor& m2)
         : motor1(m1), motor2(m2), 
           currentState(State::IDLE), 
           motor1SameAsMotor2(Config::Sequence::MOTOR1_SAME_DIR_AS_MOTOR2),
-          motor1Degrees(Config::Motor1::SEQUENCE_DEGREES) {}
+          motor1Degrees(Config::Motor1::SEQUENCE_DEGREES),
+          paused(false), pauseReported(false), perf(m1, m2) {}
+    
+    // Restore saved counters (call from setup())
+    void init() {
+        perf.init();
+    }
+    
+    // Call every loop() pass, before update()
+    void monitor() {
+        perf.sample(isActive(), paused);
+    }
+    
+    SequencePerf& getPerf() {
+        return perf;
+    }
     
     void setSameDirection(bool same) {
         motor1SameAsMotor2 = same;
@@ -55,7 +74,11 @@ public:
         Serial.println(F("°"));
         
         // Start Motor 2 moving LEFT
-        motor2.startOscillation(false);  // false = LEFT
+        unsigned long settleStart = millis();
+        if (!motor2.startOscillation(false)) {  // false = LEFT
+            stop();
+            return;
+        }
         currentState = State::MOVING_LEFT;
         
         // Start Motor 1 - same or opposite direction
@@ -63,12 +86,15 @@ public:
         delay(Config::Timing::DIR_CHANGE_DELAY_MS);
         delayMicroseconds(Config::Timing::DIR_SETUP_US);
         motor1.startMovement(motor1Degrees);
+        perf.sweepStarted(settleStart);
     }
     
     void stop() {
         motor1.disable();
         motor2.disable();
         currentState = State::IDLE;
+        paused = false;
+        perf.sweepAborted();
         Serial.println(F("Sequence stopped"));
     }
     
@@ -78,15 +104,64 @@ public:
             return;
         }
         currentState = State::STOPPING;
+        if (paused) {
+            paused = false;     // Stop where the motors are
+            perf.pauseEnded();
+            perf.sweepAborted();
+            Serial.println(F("Soft stop: Sequence was paused, stopping here..."));
+            return;
+        }
         Serial.println(F("Soft stop: Motors will finish current movement..."));
     }
     
+    // Brake both motors along their profiles to a standstill mid-sweep.
+    // Direction, remaining steps and state are kept for resume().
+    void pause() {
+        if (currentState == State::IDLE || currentState == State::STOPPING) {
+            Serial.println(F("Sequence not running"));
+            return;
+        }
+        if (paused) {
+            Serial.println(F("Sequence already paused"));
+            return;
+        }
+        motor1.pauseMovement();
+        motor2.pauseMovement();
+        perf.pauseStarted();
+        paused = true;
+        pauseReported = false;
+        Serial.println(F("Pausing: motors decelerating..."));
+    }
+    
+    // Re-accelerate and finish the interrupted sweep (no re-homing needed)
+    void resume() {
+        if (!paused) {
+            Serial.println(F("Sequence not paused"));
+            return;
+        }
+        motor1.resumeMovement();
+        motor2.resumeMovement();
+        perf.pauseEnded();
+        paused = false;
+        Serial.println(F("Sequence resumed"));
+    }
+    
     void update() {
         if (currentState == State::IDLE) return;
         
+        // Paused: report once both motors have come to a standstill
+        if (paused) {
+            if (!pauseReported && !motor1.isEnabled() && !motor2.isEnabled()) {
+                pauseReported = true;
+                Serial.println(F("Sequence paused - send 'resume' to continue"));
+            }
+            return;
+        }
+        
         // Handle soft stop - wait for both motors to complete, then go idle
         if (currentState == State::STOPPING) {
             if (motor1.isMovementComplete() && motor2.isMovementComplete()) {
+                perf.sweepCompleted();
                 currentState = State::IDLE;
                 motor2.invalidateHoming();  // Motor2 position unknown - require re-homing
                 Serial.println(F("Soft stop complete - Run 'home' before restarting seq1"));
@@ -99,15 +174,21 @@ public:
             case State::MOVING_LEFT:
                 if (motor1.isMovementComplete() && motor2.isMovementComplete()) {
                     Serial.println(F("Both motors completed, reversing direction"));
+                    perf.sweepCompleted();
+                    unsigned long settleStart = millis();
                     
                     // Motor 2 reverses: LEFT -> RIGHT
-                    motor2.startOscillation(true);
+                    if (!motor2.startOscillation(true)) {
+                        stop();
+                        break;
+                    }
                     
                     // Motor 1 reverses: same or opposite to Motor 2
                     motor1.setDirection(motor1SameAsMotor2 ? Config::CCW_LEFT : Config::CW_RIGHT);
                     delay(Config::Timing::DIR_CHANGE_DELAY_MS);
                     delayMicroseconds(Config::Timing::DIR_SETUP_US);
                     motor1.startMovement(motor1Degrees);
+                    perf.sweepStarted(settleStart);
                     
                     currentState = State::MOVING_RIGHT;
                 }
@@ -116,15 +197,21 @@ public:
             case State::MOVING_RIGHT:
                 if (motor1.isMovementComplete() && motor2.isMovementComplete()) {
                     Serial.println(F("Both motors completed, reversing direction"));
+                    perf.sweepCompleted();
+                    unsigned long settleStart = millis();
                     
                     // Motor 2 reverses: RIGHT -> LEFT
-                    motor2.startOscillation(false);
+                    if (!motor2.startOscillation(false)) {
+                        stop();
+                        break;
+                    }
                     
                     // Motor 1 reverses: same or opposite to Motor 2
                     motor1.setDirection(motor1SameAsMotor2 ? Config::CW_RIGHT : Config::CCW_LEFT);
                     delay(Config::Timing::DIR_CHANGE_DELAY_MS);
                     delayMicroseconds(Config::Timing::DIR_SETUP_US);
                     motor1.startMovement(motor1Degrees);
+                    perf.sweepStarted(settleStart);
                     
                     currentState = State::MOVING_LEFT;
                 }
@@ -140,6 +227,10 @@ public:
     bool isActive() const {
         return currentState != State::IDLE;
     }
+    
+    bool isPaused() const {
+        return paused;
+    }
 };
 
 #endif // SEQUENCE_STATE_MACHINE_H
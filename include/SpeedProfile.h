@@ -0,0 +1,245 @@
+#ifndef SPEED_PROFILE_H
+#define SPEED_PROFILE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Shape of an acceleration/deceleration profile (one set per axis)
+struct SpeedProfileParams {
+    float accelZone;        // Acceleration zone as fraction of 360° rotation
+    float decelZone;        // Deceleration zone as fraction of 360° rotation
+    float powerCurve;       // Exponent of the ramp (1.0 = linear in position, POWER_CURVE shape only)
+    float minSpeedFactor;   // Lowest speed factor (prevents stalling at start/end)
+};
+
+// A SpeedProfile is parameterised on a compile-time descriptor of its axis
+// (Motor1Profile in MainMotor.h, Motor2Profile in OscillationMotor.h):
+//
+//   SHAPE                Config::ProfileShape of the ramps
+//   STEPS_PER_ROTATION   Steps for 360° at the output shaft
+//   JERK_FRACTION        S_CURVE: share of the ramp time with changing acceleration
+//   defaults()           constexpr SpeedProfileParams from Config
+//
+// The shape is picked at compile time, so only its ramp code and tables are
+// linked in. The params stay runtime-tunable ('set m1.accel' etc.).
+
+// Same axis with another ramp shape (benchmarks, parameter sweep)
+template <typename Profile, Config::ProfileShape Shape>
+struct ProfileWithShape : Profile {
+    static constexpr Config::ProfileShape SHAPE = Shape;
+};
+
+namespace SCurve {
+    constexpr uint8_t SEGMENTS = 32;    // Table resolution over the ramp (33 floats in flash)
+
+    // 7-segment ramp in normalised time t (0..1, velocity 0..1): jerk phase,
+    // constant acceleration, jerk phase, with the jerk phases taking `jerk` of
+    // the ramp time (1 = no constant-acceleration phase). Position is
+    // normalised to 1 at the end of the ramp. Compile time only.
+    constexpr float peakAccel(float jerk) { return 1.0f / (1.0f - jerk / 2); }
+
+    constexpr float velocity(float t, float jerk) {
+        return t <= jerk / 2     ? peakAccel(jerk) * t * t / jerk
+             : t <= 1 - jerk / 2 ? peakAccel(jerk) * (t - jerk / 4)
+             :                     1 - peakAccel(jerk) * (1 - t) * (1 - t) / jerk;
+    }
+
+    constexpr float position(float t, float jerk) {
+        return 2 * (t <= jerk / 2     ? peakAccel(jerk) * t * t * t / (3 * jerk)
+                  : t <= 1 - jerk / 2 ? peakAccel(jerk) * (jerk * jerk / 24 + ((t - jerk / 4) * (t - jerk / 4) - jerk * jerk / 16) / 2)
+                  :                     0.5f - (1 - t) + peakAccel(jerk) * (1 - t) * (1 - t) * (1 - t) / (3 * jerk));
+    }
+
+    // Time at which the ramp has covered position p (bisection)
+    constexpr float timeAt(float p, float jerk, float lo = 0.0f, float hi = 1.0f, uint8_t depth = 24) {
+        return depth == 0 ? (lo + hi) / 2
+             : position((lo + hi) / 2, jerk) < p ? timeAt(p, jerk, (lo + hi) / 2, hi, depth - 1)
+             :                                     timeAt(p, jerk, lo, (lo + hi) / 2, depth - 1);
+    }
+
+    constexpr float velocityAt(float p, float jerk) {
+        return velocity(timeAt(p, jerk), jerk);
+    }
+
+    template <uint8_t... I> struct IndexList {};
+    template <uint8_t N, uint8_t... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+    template <uint8_t... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+    // Velocity at SEGMENTS + 1 evenly spaced positions, built by the compiler
+    template <typename Profile, typename Indices = typename MakeIndexList<SEGMENTS + 1>::type>
+    struct Table;
+
+    template <typename Profile, uint8_t... I>
+    struct Table<Profile, IndexList<I...>> {
+        static_assert(Profile::JERK_FRACTION > 0.0f && Profile::JERK_FRACTION <= 1.0f,
+                      "S_CURVE_JERK must be in (0, 1]");
+        static const float values[sizeof...(I)];
+    };
+
+    template <typename Profile, uint8_t... I>
+    const float Table<Profile, IndexList<I...>>::values[sizeof...(I)] PROGMEM = {
+        velocityAt((float)I / SEGMENTS, Profile::JERK_FRACTION)...
+    };
+}
+
+// Ramp shapes: factor() maps progress through a zone (0..1) to a speed
+// factor, progress() is its inverse (used to pause/resume mid-ramp)
+template <Config::ProfileShape Shape, typename Profile>
+struct RampShape;
+
+template <typename Profile>
+struct RampShape<Config::ProfileShape::POWER_CURVE, Profile> {
+    static float factor(float progress, float power) { return pow(progress, power); }
+    static float progress(float factor, float power) { return pow(factor, 1.0f / power); }
+};
+
+// Constant acceleration: speed² grows linearly with distance
+template <typename Profile>
+struct RampShape<Config::ProfileShape::TRAPEZOID, Profile> {
+    static float factor(float progress, float) { return sqrt(progress); }
+    static float progress(float factor, float) { return factor * factor; }
+};
+
+// Linear interpolation in the compile-time table: no pow()/sqrt()
+template <typename Profile>
+struct RampShape<Config::ProfileShape::S_CURVE, Profile> {
+    static float at(uint8_t i) { return pgm_read_float(&SCurve::Table<Profile>::values[i]); }
+
+    static float factor(float progress, float) {
+        if (progress >= 1.0f) return 1.0f;
+        float x = progress * SCurve::SEGMENTS;
+        uint8_t i = (uint8_t)x;
+        float a = at(i);
+        return a + (at(i + 1) - a) * (x - i);
+    }
+
+    static float progress(float factor, float) {
+        uint8_t i = 0;
+        while (i < SCurve::SEGMENTS && at(i + 1) < factor) i++;
+        if (i == SCurve::SEGMENTS) return 1.0f;
+        float a = at(i);
+        return (i + (factor - a) / (at(i + 1) - a)) / SCurve::SEGMENTS;
+    }
+};
+
+// Speed profile shared by both motors.
+// Zones are relative to one output-shaft rotation, not to the move length,
+// so acceleration feels the same for a 90° or a 720° move. factorAt() has
+// no side effects and takes the step as an argument, so it can run in the
+// step ISR as well as from loop().
+template <typename Profile>
+class SpeedProfile {
+private:
+    typedef RampShape<Profile::SHAPE, Profile> Shape;
+
+    SpeedProfileParams params;
+    unsigned long accelZoneSteps;   // Pre-calculated accel zone (based on 360°)
+    unsigned long decelZoneSteps;   // Pre-calculated decel zone (based on 360°)
+
+    // Current move
+    unsigned long totalSteps;
+    unsigned long accelEndStep;
+    unsigned long decelStartStep;
+    unsigned long holdStep;         // Pause: brake to a standstill here
+    unsigned long resumeStep;       // Resume: re-accelerate from here
+    bool holding;
+    bool resuming;
+
+    float getAccelFactor(unsigned long currentStep) const {
+        if (accelEndStep == 0) return 1.0f;
+        float progress = (float)currentStep / (float)accelEndStep;
+        float factor = Shape::factor(progress, params.powerCurve);
+        return max(factor, params.minSpeedFactor);
+    }
+
+    float getDecelFactor(unsigned long currentStep) const {
+        if (currentStep <= decelStartStep) return 1.0f;
+        unsigned long remainingSteps = totalSteps - currentStep;
+        unsigned long decelSteps = totalSteps - decelStartStep;
+        if (decelSteps == 0) return 1.0f;
+        float progress = (float)remainingSteps / (float)decelSteps;
+        float factor = Shape::factor(progress, params.powerCurve);
+        return max(factor, params.minSpeedFactor);
+    }
+
+    // Factor at a distance (in steps) from a standstill, same curve as the zones
+    float rampFactor(unsigned long distance, unsigned long zoneSteps) const {
+        if (distance >= zoneSteps) return 1.0f;
+        float factor = Shape::factor((float)distance / (float)zoneSteps, params.powerCurve);
+        return max(factor, params.minSpeedFactor);
+    }
+
+    // Inverse of rampFactor(): steps from standstill to reach the factor
+    unsigned long rampSteps(float speedFactor, unsigned long zoneSteps) const {
+        return (unsigned long)(zoneSteps * Shape::progress(speedFactor, params.powerCurve)) + 1;
+    }
+
+public:
+    SpeedProfile() : SpeedProfile(Profile::defaults()) {}
+
+    explicit SpeedProfile(const SpeedProfileParams& p)
+        : params(p), accelZoneSteps(0), decelZoneSteps(0),
+          totalSteps(0), accelEndStep(0), decelStartStep(0),
+          holdStep(0), resumeStep(0), holding(false), resuming(false) {
+        setParams(p);
+    }
+
+    // Change the zones/curve (takes effect at the next begin())
+    void setParams(const SpeedProfileParams& p) {
+        params = p;
+        accelZoneSteps = (unsigned long)(Profile::STEPS_PER_ROTATION * p.accelZone);
+        decelZoneSteps = (unsigned long)(Profile::STEPS_PER_ROTATION * p.decelZone);
+    }
+
+    const SpeedProfileParams& getParams() const { return params; }
+
+    static constexpr Config::ProfileShape getShape() { return Profile::SHAPE; }
+
+    // Plan a move of the given length
+    void begin(unsigned long steps) {
+        totalSteps = steps;
+        accelEndStep = accelZoneSteps;
+        decelStartStep = (totalSteps > decelZoneSteps) ? (totalSteps - decelZoneSteps) : 0;
+        holding = false;
+        resuming = false;
+    }
+
+    // Pause: returns the step at which a move running at speedFactor comes
+    // to a standstill along the decel curve (capped at the end of the move)
+    unsigned long hold(unsigned long currentStep, float speedFactor) {
+        holdStep = currentStep + rampSteps(speedFactor, decelZoneSteps);
+        if (holdStep > totalSteps) holdStep = totalSteps;
+        holding = true;
+        return holdStep;
+    }
+
+    // Resume: re-accelerate along the accel curve, starting from speedFactor
+    // (minSpeedFactor from a standstill, higher if still braking)
+    void release(unsigned long currentStep, float speedFactor) {
+        unsigned long offset = rampSteps(speedFactor, accelZoneSteps);
+        resumeStep = (currentStep > offset) ? (currentStep - offset) : 0;
+        holding = false;
+        resuming = true;
+    }
+
+    // Speed factor (minSpeedFactor..1) at the given step of the move
+    float factorAt(unsigned long currentStep) const {
+        float factor = 1.0f;
+        if (currentStep < accelEndStep || currentStep > decelStartStep) {
+            factor = min(getAccelFactor(currentStep), getDecelFactor(currentStep));
+        }   // else cruising: skip the ramp math
+        if (holding) {
+            factor = min(factor, rampFactor(holdStep > currentStep ? holdStep - currentStep : 0, decelZoneSteps));
+        }
+        if (resuming) {
+            factor = min(factor, rampFactor(currentStep - resumeStep, accelZoneSteps));
+        }
+        return factor;
+    }
+
+    unsigned long getTotalSteps() const { return totalSteps; }
+
+    float getMinSpeedFactor() const { return params.minSpeedFactor; }
+};
+
+#endif // SPEED_PROFILE_H
@@ -0,0 +1,171 @@
+#ifndef STEP_TRACE_H
+#define STEP_TRACE_H
+
+#include <Arduino.h>
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "Config.h"
+
+// Step timestamp recorder for verifying the delivered speed profile.
+//
+// Armed by the 'trace' command, triggered by the first step of the next move
+// on either axis, then the step ISRs log every Nth step until the buffer is
+// full. Each entry is 16 bits: bit 15 = axis (0 = Motor1, 1 = Motor2),
+// bits 0-14 = microseconds since the previous entry of that axis, saturated
+// at 0x7FFF. The first entry of the triggering axis has delta 0; move length
+// and position of both axes at the trigger go into the dump header.
+//
+// 'tracedump' sends a binary image; tools/trace/trace_analyze.py decodes it.
+
+class StepTrace {
+public:
+    enum class State : uint8_t {
+        IDLE,
+        ARMED,      // Waiting for the first step of a move
+        RECORDING,
+        FULL
+    };
+
+    static constexpr uint16_t CAPACITY = Config::Trace::ENABLED ? Config::Trace::BUFFER_SIZE : 1;
+    static constexpr uint16_t MAX_DELTA = 0x7FFF;
+
+private:
+    MainMotor& motor1;
+    OscillationMotor& motor2;
+
+    uint16_t entries[CAPACITY];
+    volatile uint16_t count;
+    volatile State state;
+    bool fullReported;
+    uint8_t decimation;             // Record every Nth step
+    uint8_t skip[2];
+    unsigned long lastMicros[2];
+    unsigned long moveSteps[2];     // Move length of each axis at trigger
+    unsigned long startStep[2];     // Step count of each axis at trigger
+    bool profileActive[2];          // Speed profile in use at trigger (off while homing)
+
+    // Binary dump helpers (little-endian, AVR native order)
+    static void writeBytes(const void* data, size_t len) {
+        Serial.write((const uint8_t*)data, len);
+    }
+
+    // 36 bytes per axis
+    template <typename Profile>
+    void writeAxisHeader(uint8_t axis, const StepperMotor& motor, const SpeedProfile<Profile>& profile) {
+        uint32_t stepsPerRotation = motor.getStepsPerRotation();
+        float stepFreq = motor.getStepFreq();
+        const SpeedProfileParams& p = profile.getParams();
+        uint32_t total = moveSteps[axis];
+        uint32_t start = startStep[axis];
+        uint8_t updateSteps = motor.getProfileUpdateSteps();
+        uint8_t flags = profileActive[axis] ? 1 : 0;
+        uint8_t shape[2] = { (uint8_t)Profile::SHAPE, 0 };   // Ramp shape, S_CURVE jerk in %
+        if (Profile::SHAPE == Config::ProfileShape::S_CURVE) {
+            shape[1] = (uint8_t)(Profile::JERK_FRACTION * 100.0f + 0.5f);
+        }
+        writeBytes(&stepsPerRotation, 4);
+        writeBytes(&stepFreq, 4);
+        writeBytes(&p.accelZone, 4);
+        writeBytes(&p.decelZone, 4);
+        writeBytes(&p.powerCurve, 4);
+        writeBytes(&p.minSpeedFactor, 4);
+        writeBytes(&total, 4);
+        writeBytes(&start, 4);
+        writeBytes(&updateSteps, 1);
+        writeBytes(&flags, 1);
+        writeBytes(shape, 2);
+    }
+
+public:
+    StepTrace(MainMotor& m1, OscillationMotor& m2)
+        : motor1(m1), motor2(m2), count(0), state(State::IDLE), fullReported(true),
+          decimation(1), skip{ 0, 0 }, lastMicros{ 0, 0 },
+          moveSteps{ 0, 0 }, startStep{ 0, 0 }, profileActive{ false, false } {}
+
+    void arm(uint8_t everyNthStep) {
+        noInterrupts();
+        state = State::IDLE;
+        count = 0;
+        decimation = everyNthStep ? everyNthStep : 1;
+        skip[0] = skip[1] = 0;
+        fullReported = false;
+        state = State::ARMED;
+        interrupts();
+    }
+
+    // Step ISR hook: call after a completed step
+    void record(uint8_t axis, unsigned long stepCount) {
+        if (state == State::ARMED) {
+            if (stepCount != 1) return;          // Trigger on move start only
+            lastMicros[0] = lastMicros[1] = micros();
+            moveSteps[0] = motor1.getTotalSteps();
+            moveSteps[1] = motor2.getTotalSteps();
+            startStep[0] = motor1.getStepCount();
+            startStep[1] = motor2.getStepCount();
+            profileActive[0] = true;
+            profileActive[1] = motor2.isSpeedProfileEnabled();
+            skip[0] = skip[1] = decimation - 1;  // Log the triggering step
+            state = State::RECORDING;
+        }
+        if (state != State::RECORDING) return;
+        if (++skip[axis] < decimation) return;
+        skip[axis] = 0;
+
+        unsigned long now = micros();
+        unsigned long delta = now - lastMicros[axis];
+        lastMicros[axis] = now;
+        entries[count++] = ((uint16_t)axis << 15) | (uint16_t)min(delta, (unsigned long)MAX_DELTA);
+        if (count >= CAPACITY) state = State::FULL;
+    }
+
+    State getState() const { return state; }
+    uint16_t getCount() const { return count; }
+
+    // Returns true (once) when the buffer has filled up
+    bool takeFullReport() {
+        if (state != State::FULL || fullReported) return false;
+        fullReported = true;
+        return true;
+    }
+
+    // Binary image: "FFTR", version, decimation, count, 2 axis headers, entries
+    void dump() {
+        State was = state;
+        state = State::IDLE;    // Freeze while sending, resume afterwards
+        uint16_t n = count;
+
+        Serial.print(F("TRACE BEGIN "));
+        Serial.println(8 + 2 * 36 + 2 * (unsigned long)n);
+        const uint8_t version = 1;
+        writeBytes("FFTR", 4);
+        writeBytes(&version, 1);
+        writeBytes(&decimation, 1);
+        writeBytes(&n, 2);
+        writeAxisHeader(0, motor1, motor1.getProfile());
+        writeAxisHeader(1, motor2, motor2.getProfile());
+        writeBytes(entries, 2 * (size_t)n);
+        Serial.println();
+        Serial.println(F("TRACE END"));
+
+        state = was;
+    }
+
+    void printStatus() const {
+        Serial.print(F("Trace: "));
+        switch (state) {
+            case State::IDLE:      Serial.print(F("idle")); break;
+            case State::ARMED:     Serial.print(F("armed, waiting for move start")); break;
+            case State::RECORDING: Serial.print(F("recording")); break;
+            case State::FULL:      Serial.print(F("complete")); break;
+        }
+        Serial.print(F(", "));
+        Serial.print(count);
+        Serial.print(F("/"));
+        Serial.print(CAPACITY);
+        Serial.print(F(" entries, every "));
+        Serial.print(decimation);
+        Serial.println(F(" steps"));
+    }
+};
+
+#endif // STEP_TRACE_H
@@ -13,15 +13,28 @@ protected:
     const uint16_t stepsPerRev;
     const uint8_t microsteps;
     const uint8_t gearRatio;
-    const float targetRPM;
+    const uint8_t profileUpdateSteps;   // Raise a profile update request every N steps
+    float targetRPM;                    // Runtime tunable (setTargetRPM)
     
     // State variables
     volatile unsigned long stepCount;
     volatile bool stepLevel;
     volatile bool enabled;
+    volatile uint8_t stepsUntilUpdate;
+    volatile bool profileUpdateDue;     // Set by ISR, cleared by takeProfileUpdateRequest()
     unsigned long totalSteps;
     float stepFreq;
     
+    // Disabled mid-pulse (limit switch, stop): drop the step pin so the next
+    // move's first pulse has a rising edge. The driver already took the step.
+    void finishCutPulse() {
+        if (stepLevel) {
+            digitalWrite(stepPin, LOW);
+            stepCount++;
+        }
+        stepLevel = false;
+    }
+    
     // Calculate step frequency
     void calculateStepFreq() {
         float motorRPM = targetRPM * gearRatio;
@@ -30,10 +43,12 @@ protected:
     
 public:
     StepperMotor(uint8_t step, uint8_t dir, 
-                 uint16_t spr, uint8_t ms, uint8_t gr, float rpm)
+                 uint16_t spr, uint8_t ms, uint8_t gr, float rpm, uint8_t updateSteps)
         : stepPin(step), dirPin(dir), 
-          stepsPerRev(spr), microsteps(ms), gearRatio(gr), targetRPM(rpm),
-          stepCount(0), stepLevel(false), enabled(false), totalSteps(0) {
+          stepsPerRev(spr), microsteps(ms), gearRatio(gr),
+          profileUpdateSteps(updateSteps), targetRPM(rpm),
+          stepCount(0), stepLevel(false), enabled(false),
+          stepsUntilUpdate(updateSteps), profileUpdateDue(false), totalSteps(0) {
         calculateStepFreq();
     }
     
@@ -46,16 +61,25 @@ public:
         digitalWrite(dirPin, HIGH);
     }
     
-    // ISR callback - must be fast!
-    virtual void step() {
+    // ISR callback - must be fast! Returns true when a step was completed.
+    virtual bool step() {
         if (enabled && stepCount < totalSteps) {
             stepLevel = !stepLevel;
             digitalWrite(stepPin, stepLevel);
-            if (!stepLevel) stepCount++;
+            if (!stepLevel) {
+                stepCount++;
+                // Position-based profile updates: same ramp resolution at any speed
+                if (--stepsUntilUpdate == 0) {
+                    stepsUntilUpdate = profileUpdateSteps;
+                    profileUpdateDue = true;
+                }
+                return true;
+            }
         } else {
             enabled = false;
-            stepLevel = false;
+            finishCutPulse();
         }
+        return false;
     }
     
     // Control methods
@@ -73,17 +97,40 @@ public:
     
     void resetStepCount() {
         stepCount = 0;
+        stepsUntilUpdate = profileUpdateSteps;
+        profileUpdateDue = true;    // New move: set the starting speed right away
+    }
+    
+    // Returns true (once) if the ISR requested a speed profile update
+    bool takeProfileUpdateRequest() {
+        if (!profileUpdateDue) return false;
+        profileUpdateDue = false;
+        return true;
     }
     
     void setTotalSteps(unsigned long steps) {
         totalSteps = steps;
     }
     
+    // Change cruise speed (call between moves: the next move uses it)
+    void setTargetRPM(float rpm) {
+        targetRPM = rpm;
+        calculateStepFreq();
+    }
+    
     // Getters (inline for performance)
     inline bool isEnabled() const { return enabled; }
+    inline bool isPulseHigh() const { return stepLevel; }
     inline unsigned long getStepCount() const { return stepCount; }
     inline unsigned long getTotalSteps() const { return totalSteps; }
     inline float getStepFreq() const { return stepFreq; }
+    inline float getTargetRPM() const { return targetRPM; }
+    inline uint8_t getProfileUpdateSteps() const { return profileUpdateSteps; }
+    
+    // Steps for one 360° rotation of the output shaft
+    unsigned long getStepsPerRotation() const {
+        return (unsigned long)gearRatio * stepsPerRev * microsteps;
+    }
     
     // Calculate timer period in microseconds
     unsigned long getTimerPeriod() const {
@@ -6,6 +6,7 @@
  * - Motor 2: Fine motor with homing and limit switches
  * - Synchronized or opposite direction modes
  * - Serial command interface
+ * - Idle power mode (step timers off, driver off, CPU idle sleep)
  * 
  * Refactored with OOP principles: SPOT, SSOT, DRY
  */
@@ -19,24 +20,91 @@
 #include "MainMotor.h"
 #include "OscillationMotor.h"
 #include "SequenceStateMachine.h"
+#include "EmergencyStop.h"
+#include "StepTrace.h"
+#include "MotionTuning.h"
+#include "IdlePower.h"
 #include "CommandHandler.h"
 
 // === Global Motor Instances ===
 MainMotor motor1;
 OscillationMotor motor2;
 SequenceStateMachine sequence(motor1, motor2);
-CommandHandler commandHandler(motor1, motor2, sequence);
+EmergencyStop eStop(motor1, motor2);
+StepTrace stepTrace(motor1, motor2);
+MotionTuning tuning(motor1, motor2);
+IdlePower power(motor1, motor2, eStop, sequence);
+CommandHandler commandHandler(motor1, motor2, sequence, eStop, stepTrace, tuning);
 
 // === ISR Wrappers ===
 // Note: ISRs must be global functions, not class methods
 // They delegate to the motor instances
 
+// The serial e-stop byte is picked out of the RX buffer from interrupts, so
+// a stop never waits for loop(). Timer0 (millis) always runs, and its compare
+// A vector polls every 1.024 ms whatever the step timers do (stopped at idle,
+// slow ramps, tuned-down minimum speed). The step ISRs poll as well, which
+// shortens the wait while an axis moves fast. Worst case: one byte time
+// (87 µs) plus one Timer0 period.
+
+ISR(TIMER0_COMPA_vect) {
+    eStop.pollSerial();
+}
+
 void stepMotor1() {
-    motor1.step();
+    if (eStop.pollSerial()) return;
+    if (motor1.step() && Config::Trace::ENABLED) {
+        stepTrace.record(0, motor1.getStepCount());
+    }
 }
 
 void stepMotor2() {
-    motor2.step();
+    if (eStop.pollSerial()) return;
+    if (motor2.step() && Config::Trace::ENABLED) {
+        stepTrace.record(1, motor2.getStepCount());
+    }
+}
+
+void emergencyStopInput() {
+    eStop.trigger(EStopSource::INPUT_PIN);
+}
+
+// === Speed Profile Service ===
+// The step ISRs request an update every PROFILE_UPDATE_STEPS steps, so ramp
+// resolution is uniform in position rather than in time. Requests are served
+// here from loop() and from yield(), which the core calls while delay() waits,
+// so latency stays bounded even inside homing/sequence delays. Motor 1 in
+// velocity (jog) mode is paced by time instead (JOG_UPDATE_MS). Periods go
+// through IdlePower, which holds them while a step timer is stopped.
+
+void serviceSpeedProfiles() {
+    if (motor1.takeVelocityUpdateRequest()) {
+        float speedFactor1 = motor1.updateVelocity();
+        unsigned long newPeriod1 = (unsigned long)(motor1.getTimerPeriod() / speedFactor1);
+        power.setPeriod(0, newPeriod1);
+    } else if (motor1.takeProfileUpdateRequest() && motor1.isEnabled()) {
+        float speedFactor1 = motor1.updateSpeedProfile();
+        unsigned long newPeriod1 = (unsigned long)(motor1.getTimerPeriod() / speedFactor1);
+        power.setPeriod(0, newPeriod1);
+    }
+    
+    if (motor2.takeProfileUpdateRequest() && motor2.isEnabled()) {
+        float speedFactor2 = motor2.updateSpeedProfile();
+        unsigned long newPeriod2 = (unsigned long)(motor2.getTimerPeriod() / speedFactor2);
+        power.setPeriod(1, newPeriod2);
+    }
+}
+
+// === Idle Power ===
+// Start/stop the step timers and Motor 2's driver with the axes (IdlePower.h)
+
+void serviceIdlePower() {
+    power.update();
+}
+
+void yield() {
+    serviceSpeedProfiles();
+    serviceIdlePower();
 }
 
 // === Setup ===
@@ -48,6 +116,18 @@ void setup() {
     motor1.init();
     motor2.init();
     
+    // Replace compiled defaults with tuning saved in EEPROM (if any)
+    tuning.init();
+    
+    // Restore sequence counters saved by 'perf save' (if any)
+    sequence.init();
+    
+    // Emergency stop (serial byte always, external input if configured)
+    eStop.init();
+    if (Config::EStop::INPUT_ENABLED) {
+        attachInterrupt(digitalPinToInterrupt(Config::EStop::INPUT_PIN), emergencyStopInput, RISING);
+    }
+    
     // Setup Timer 1 for Motor 1
     Timer1.initialize(motor1.getTimerPeriod());
     Timer1.attachInterrupt(stepMotor1);
@@ -56,6 +136,9 @@ void setup() {
     Timer3.initialize(motor2.getTimerPeriod());
     Timer3.attachInterrupt(stepMotor2);
     
+    // Hold both step timers until their axis moves, Motor 2 driver enabled
+    power.init();
+    
     Serial.println(F("System initialized"));
     Serial.print(F("Motor 1: Timer period = "));
     Serial.print(motor1.getTimerPeriod());
@@ -80,44 +163,69 @@ void loop() {
         firstLoop = false;
     }
     
+    // Report a latched emergency stop and drop everything that would restart motion
+    eStop.pollInput();
+    if (eStop.takeReport()) {
+        eStop.printFault();
+        sequence.stop();
+        if (motor2.getHomingState() != HomingState::IDLE) {
+            motor2.abortHoming();
+        }
+        motor2.invalidateHoming();
+    }
+    
+    if (stepTrace.takeFullReport()) {
+        Serial.print(F("Trace complete: "));
+        Serial.print(stepTrace.getCount());
+        Serial.println(F(" entries - send 'tracedump'"));
+    }
+    
     // Update debounced limit switches
     motor2.updateSwitches();
     
     // Process serial commands
     commandHandler.update();
     
-    // Update homing state machine if active
-    if (motor2.getHomingState() != HomingState::IDLE) {
+    // Update homing state machine if active (not once an e-stop is latched:
+    // Ctrl-X may have been caught by commandHandler after the report above)
+    if (motor2.getHomingState() != HomingState::IDLE && !eStop.isLatched()) {
         motor2.updateHoming();
     }
     
     // Auto-start sequence after homing completes (if configured)
     if (Config::Sequence::AUTO_START_AFTER_HOMING && !autoStartExecuted) {
         if (motor2.getHomingState() == HomingState::IDLE && motor2.isHomingComplete()) {
-            Serial.println(F("Auto-starting seq1 after homing..."));
-            sequence.start();
+            if (motor1.isJogging()) {
+                Serial.println(F("Auto-start skipped: Motor 1 jogging"));
+            } else {
+                Serial.println(F("Auto-starting seq1 after homing..."));
+                sequence.start();
+            }
             autoStartExecuted = true;
         }
     }
     
+    // Sequence counters: homing runs, first motor done, time at minimum speed
+    sequence.monitor();
+    
+    // Swap in staged tuning while no axis moves (e.g. between seq1 half-cycles,
+    // but not during a pause: the interrupted sweep resumes with its own plan)
+    if (!sequence.isPaused()) {
+        tuning.applyPending(sequence.isActive(), motor2.getHomingState() != HomingState::IDLE);
+    }
+    
     // Update sequence state machine if active
-    if (sequence.isActive()) {
+    if (sequence.isActive() && !eStop.isLatched()) {
         sequence.update();
     }
     
-    // Update speed profiles
-    if (motor1.isEnabled()) {
-        float speedFactor1 = motor1.updateSpeedProfile();
-        unsigned long newPeriod1 = (unsigned long)(motor1.getTimerPeriod() / speedFactor1);
-        Timer1.setPeriod(newPeriod1);
-    }
+    // Serve pending speed profile updates (also served from yield())
+    serviceSpeedProfiles();
     
-    if (motor2.isEnabled()) {
-        float speedFactor2 = motor2.updateSpeedProfile();
-        unsigned long newPeriod2 = (unsigned long)(motor2.getTimerPeriod() / speedFactor2);
-        Timer3.setPeriod(newPeriod2);
-    }
+    // Start step timers for moves begun above at the period just set (also
+    // done from yield())
+    serviceIdlePower();
     
-    // Small delay to prevent excessive loop rate
-    delay(10);
+    // Small delay to prevent excessive loop rate (idle sleep when no axis runs)
+    power.wait(10);
 }
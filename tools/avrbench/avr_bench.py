@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+AVR cycle benchmark runner with regression check.
+
+Runs the benchmark firmware (tools/avrbench/bench.cpp) under simavr, collects
+the "BENCH <name> <cycles>" lines it prints, adds code sizes from the symbol
+table (the benchmark wrappers, which contain the inlined header code, plus
+every out-of-line function of the firmware classes) and writes everything to
+a JSON file. Fails when a cycle count or code size grows by more than the
+tolerance over tools/avrbench/baseline.json, when a benchmark is missing
+from either side, or when there is no baseline file at all. Only
+--update-baseline creates or refreshes that file.
+
+PlatformIO runs this after linking the 'avrbench' environment:
+
+    pio run -e avrbench
+
+Standalone:
+
+    python3 tools/avrbench/avr_bench.py .pio/build/avrbench/firmware.elf \\
+        [--baseline tools/avrbench/baseline.json] [--out results.json] \\
+        [--simavr simavr] [--nm avr-nm] [--tolerance 2] [--update-baseline]
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+MCU = "atmega2560"
+F_CPU = 16000000
+
+# Classes whose out-of-line functions are reported under "functions"
+CLASSES = ("StepperMotor", "ProfiledMotor", "MainMotor", "OscillationMotor",
+           "SpeedProfile", "RampShape", "SequenceStateMachine", "CommandHandler",
+           "EmergencyStop", "StepTrace", "MemoryMonitor", "MotionTuning", "SequencePerf", "IdlePower",
+           "Bounce")
+
+BENCH_RE = re.compile(r"BENCH (\w+) (\d+)")
+DONE_RE = re.compile(r"BENCH_DONE (\d+)")
+ANSI_RE = re.compile(r"\x1b\[[0-9;]*m")
+NM_RE = re.compile(r"^[0-9a-fA-F]+ ([0-9a-fA-F]+) [tTwW] (.+)$")
+WRAPPER_RE = re.compile(r"^bench_(\w+)\(\)$")
+
+
+def run_simavr(simavr, elf, timeout):
+    """Returns {name: cycles}. simavr exits when the firmware sleeps with interrupts off."""
+    proc = subprocess.run([simavr, "-m", MCU, "-f", str(F_CPU), elf],
+                          capture_output=True, text=True, errors="replace", timeout=timeout)
+    output = ANSI_RE.sub("", proc.stdout + proc.stderr)
+    cycles = {m.group(1): int(m.group(2)) for m in BENCH_RE.finditer(output)}
+    done = DONE_RE.search(output)
+    if not done or int(done.group(1)) != len(cycles):
+        raise RuntimeError("benchmark run incomplete (%d results, exit %d):\n%s"
+                           % (len(cycles), proc.returncode, output[-2000:]))
+    return cycles
+
+
+def read_sizes(nm, elf):
+    """Returns ({benchmark: wrapper bytes}, {function: bytes})."""
+    out = subprocess.run([nm, "-C", "-S", elf], check=True,
+                         capture_output=True, text=True).stdout
+    wrappers, functions = {}, {}
+    for line in out.splitlines():
+        m = NM_RE.match(line.strip())
+        if not m:
+            continue
+        size, name = int(m.group(1), 16), m.group(2)
+        w = WRAPPER_RE.match(name)
+        if w:
+            wrappers[w.group(1)] = size
+        elif name.split("::")[0].split("<")[0] in CLASSES:    # Templates by class name
+            functions[name] = functions.get(name, 0) + size
+    return wrappers, functions
+
+
+def collect(elf, simavr, nm, timeout=60):
+    cycles = run_simavr(simavr, elf, timeout)
+    wrappers, functions = read_sizes(nm, elf)
+    return {
+        "mcu": MCU,
+        "f_cpu": F_CPU,
+        "benchmarks": {name: {"cycles": c, "size": wrappers.get(name, 0)}
+                       for name, c in sorted(cycles.items())},
+        "functions": dict(sorted(functions.items())),
+    }
+
+
+def compare(results, baseline, tolerance_pct, out=sys.stdout):
+    """Prints a table and returns the list of regressions."""
+    limit = 1.0 + tolerance_pct / 100.0
+    failures = []
+
+    def grade(what, value, base):
+        if base is None:
+            return "new"
+        if value > base * limit:
+            failures.append("%s: %d -> %d" % (what, base, value))
+            return "REGRESSION"
+        if value < base:
+            return "-%.1f%%" % (100.0 * (base - value) / base)
+        return ""
+
+    base_bench = baseline.get("benchmarks", {})
+    print("%-20s %9s %9s %7s %7s" % ("benchmark", "cycles", "baseline", "bytes", "baseline"), file=out)
+    for name, r in results["benchmarks"].items():
+        b = base_bench.get(name, {})
+        if not b:
+            failures.append("%s: not in the baseline" % name)
+        flags = [grade(name + " cycles", r["cycles"], b.get("cycles")),
+                 grade(name + " size", r["size"], b.get("size"))]
+        print("%-20s %9d %9s %7d %7s  %s" % (name, r["cycles"], b.get("cycles", "-"),
+                                           r["size"], b.get("size", "-"),
+                                           " ".join(f for f in flags if f)), file=out)
+    for name in base_bench:
+        if name not in results["benchmarks"]:
+            failures.append("%s: benchmark missing from this run" % name)
+
+    base_func = baseline.get("functions", {})
+    for name, size in results["functions"].items():
+        if name in base_func:
+            grade(name + " size", size, base_func[name])
+
+    for fail in failures:
+        print("Benchmark regression - " + fail, file=out)
+    return failures
+
+
+def check(elf, baseline_path, out_path, simavr, nm, tolerance=None, update=False):
+    results = collect(elf, simavr, nm)
+    with open(out_path, "w") as f:
+        json.dump(results, f, indent=4)
+        f.write("\n")
+    print("Results written to %s" % out_path)
+
+    baseline = {}
+    if os.path.exists(baseline_path):
+        with open(baseline_path) as f:
+            baseline = json.load(f)
+    elif not update:
+        print("Benchmark regression - no baseline at %s: record one with --update-baseline and commit it"
+              % baseline_path)
+        return 1
+    if tolerance is None:
+        tolerance = baseline.get("tolerance_pct", 2.0)
+
+    failures = compare(results, baseline, tolerance)
+    if update:
+        baseline.update({k: results[k] for k in ("mcu", "f_cpu", "benchmarks", "functions")})
+        baseline.setdefault("tolerance_pct", tolerance)
+        with open(baseline_path, "w") as f:
+            json.dump(baseline, f, indent=4)
+            f.write("\n")
+        print("Baseline updated: %s" % baseline_path)
+        return 0
+    return 1 if failures else 0
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--baseline", default=os.path.join(here, "baseline.json"))
+    parser.add_argument("--out", help="results file (default: bench_results.json next to the ELF)")
+    parser.add_argument("--simavr", default="simavr")
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--tolerance", type=float, help="allowed growth in percent (default from baseline)")
+    parser.add_argument("--update-baseline", action="store_true")
+    args = parser.parse_args()
+    out = args.out or os.path.join(os.path.dirname(os.path.abspath(args.elf)), "bench_results.json")
+    return check(args.elf, args.baseline, out, args.simavr, args.nm, args.tolerance, args.update_baseline)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+except NameError:
+    env = None
+
+if env is not None:
+    def _post_link(source, target, env):
+        project = env.subst("$PROJECT_DIR")
+        baseline = os.path.join(project, env.GetProjectOption("custom_bench_baseline", "tools/avrbench/baseline.json"))
+        simavr = os.path.join(env.PioPlatform().get_package_dir("tool-simavr") or "", "bin", "simavr")
+        if not os.path.exists(simavr):
+            simavr = "simavr"
+        nm = env.subst("$CC").replace("gcc", "nm")
+        elf = str(target[0])
+        out = os.path.join(os.path.dirname(elf), "bench_results.json")
+        return check(elf, baseline, out, simavr, nm)
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _post_link)
+elif __name__ == "__main__":
+    sys.exit(main())
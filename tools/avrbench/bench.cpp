@@ -0,0 +1,264 @@
+/**
+ * AVR cycle benchmarks (ATmega2560, run under simavr)
+ *
+ * Built by the 'avrbench' PlatformIO environment in place of src/. Every
+ * benchmark is a noinline wrapper around one call into the real headers, so
+ * the code measured is the code the firmware compiles (same flags, soft-float,
+ * devirtualised step()). setup() times each wrapper with interrupts off and
+ * prints
+ *
+ *     BENCH <name> <cycles>
+ *
+ * then sleeps with interrupts disabled, which makes simavr exit.
+ * tools/avrbench/avr_bench.py runs the ELF, adds code sizes from the symbol
+ * table and compares both against tools/avrbench/baseline.json.
+ *
+ * Cycle counting: Timer5 at clk/1 gives the exact count modulo 65536 and
+ * Timer4 at clk/1024 resolves the wraps. Timer0 (millis) and Timer1/Timer3
+ * (step timers) are left alone. The cost of timing an empty wrapper is
+ * subtracted, so each result is the cycles of the wrapped call alone.
+ *
+ * Homing transitions that call delay() are not timed (delay needs
+ * interrupts); 'homing_poll' is the per-loop() cost while homing runs.
+ */
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <TimerOne.h>
+
+#include "Config.h"
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "SequenceStateMachine.h"
+#include "EmergencyStop.h"
+#include "StepTrace.h"
+#include "MotionTuning.h"
+#include "CommandHandler.h"
+
+// Same objects as src/fairfanpio.cpp
+MainMotor motor1;
+OscillationMotor motor2;
+SequenceStateMachine sequence(motor1, motor2);
+EmergencyStop eStop(motor1, motor2);
+StepTrace stepTrace(motor1, motor2);
+MotionTuning tuning(motor1, motor2);
+CommandHandler commandHandler(motor1, motor2, sequence, eStop, stepTrace, tuning);
+
+// eStop.init() enables the Timer0 compare poll: same vector as the firmware
+ISR(TIMER0_COMPA_vect) {
+    eStop.pollSerial();
+}
+
+// Motor2's profile on its own (startOscillation() needs a homed axis), in
+// each ramp shape
+SpeedProfile<ProfileWithShape<Motor2Profile, Config::ProfileShape::POWER_CURVE>> profile2;
+SpeedProfile<ProfileWithShape<Motor2Profile, Config::ProfileShape::TRAPEZOID>> profile2Trapezoid;
+SpeedProfile<ProfileWithShape<Motor2Profile, Config::ProfileShape::S_CURVE>> profile2SCurve;
+
+// Results go here so the optimiser keeps the calls
+volatile float sinkFloat;
+volatile unsigned long sinkLong;
+volatile bool sinkBool;
+
+// Queue text in Serial's RX ring as if the USART had received it
+struct SerialRxInject : public HardwareSerial {
+    static void push(HardwareSerial& port, const char* text) {
+        while (*text) {
+            rx_buffer_index_t head = port.*(&SerialRxInject::_rx_buffer_head);
+            (port.*(&SerialRxInject::_rx_buffer))[head] = (unsigned char)*text++;
+            port.*(&SerialRxInject::_rx_buffer_head) = (rx_buffer_index_t)((head + 1) % SERIAL_RX_BUFFER_SIZE);
+        }
+    }
+};
+
+// === Benchmarks ===
+
+#define BENCH(name) static void __attribute__((noinline, noclone)) bench_##name()
+
+BENCH(empty) { __asm__ __volatile__(""); }
+
+// One full step pulse = two timer ISRs (rising edge, falling edge + count)
+BENCH(step_pulse) {
+    sinkBool = motor1.step();
+    sinkBool = motor1.step();
+}
+
+BENCH(step_disabled) { sinkBool = motor2.step(); }
+
+BENCH(timer_period) { sinkLong = motor1.getTimerPeriod(); }
+
+BENCH(m1_update_ramp) { sinkFloat = motor1.updateSpeedProfile(); }
+
+BENCH(m1_update_cruise) { sinkFloat = motor1.updateSpeedProfile(); }
+
+BENCH(m1_update_jog) { sinkFloat = motor1.updateVelocity(); }
+
+// Body of serviceSpeedProfiles() for one axis
+BENCH(m1_service_ramp) {
+    float speedFactor1 = motor1.updateSpeedProfile();
+    Timer1.setPeriod((unsigned long)(motor1.getTimerPeriod() / speedFactor1));
+}
+
+BENCH(m2_factor_ramp) { sinkFloat = profile2.factorAt(4000); }
+
+BENCH(m2_factor_ramp_trapezoid) { sinkFloat = profile2Trapezoid.factorAt(4000); }
+
+BENCH(m2_factor_ramp_scurve) { sinkFloat = profile2SCurve.factorAt(4000); }
+
+BENCH(estop_poll) { sinkBool = eStop.pollSerial(); }
+
+BENCH(trace_record_idle) { stepTrace.record(0, 2); }
+
+BENCH(cmd_char) { commandHandler.update(); }
+
+BENCH(cmd_mode) { commandHandler.update(); }
+
+BENCH(cmd_deg) { commandHandler.update(); }
+
+BENCH(cmd_unknown) { commandHandler.update(); }
+
+BENCH(homing_poll) {
+    motor2.updateSwitches();
+    motor2.updateHoming();
+}
+
+// === Fixtures (run untimed before/after a benchmark) ===
+
+void advanceMotor1(unsigned long steps) {
+    while (motor1.getStepCount() < steps) motor1.step();
+}
+
+void prepareRamp() {
+    motor1.startMovement(Config::Motor1::SEQUENCE_DEGREES);
+    advanceMotor1(800);    // Middle of the acceleration zone (pow() path)
+}
+
+void prepareCruise() { advanceMotor1(20000); }
+
+void prepareJog() {
+    motor1.disable();
+    motor1.setTargetVelocity(Config::Motor1::TARGET_RPM);
+}
+
+void finishJog() { motor1.disable(); }
+
+// seq1 sweep over ~180°
+void prepareProfile2() {
+    profile2.begin(35000);
+    profile2Trapezoid.begin(35000);
+    profile2SCurve.begin(35000);
+}
+
+void prepareChar() { SerialRxInject::push(Serial, "m"); }
+
+void finishChar() {
+    SerialRxInject::push(Serial, "ode\n");   // Complete the command, untimed
+    commandHandler.update();
+}
+
+void prepareMode() { SerialRxInject::push(Serial, "mode\n"); }
+void prepareDeg() { SerialRxInject::push(Serial, "deg360\n"); }
+void prepareUnknown() { SerialRxInject::push(Serial, "bogus\n"); }
+
+void prepareHoming() {
+    motor2.init();
+    // Drive both switch inputs HIGH (not pressed): PINx reads back the output
+    pinMode(Config::Motor2::LEFT_SWITCH_PIN, OUTPUT);
+    digitalWrite(Config::Motor2::LEFT_SWITCH_PIN, HIGH);
+    pinMode(Config::Motor2::RIGHT_SWITCH_PIN, OUTPUT);
+    digitalWrite(Config::Motor2::RIGHT_SWITCH_PIN, HIGH);
+    motor2.updateSwitches();
+    motor2.startHoming();
+    motor2.updateHoming();   // Starts the move to the LEFT switch
+}
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+    void (*prepare)();
+    void (*finish)();
+};
+
+const Benchmark BENCHMARKS[] = {
+    { "step_disabled",     bench_step_disabled,      nullptr,         nullptr },
+    { "step_pulse",        bench_step_pulse,         prepareRamp,     nullptr },
+    { "timer_period",      bench_timer_period,       nullptr,         nullptr },
+    { "m1_update_ramp",    bench_m1_update_ramp,     prepareRamp,     nullptr },
+    { "m1_service_ramp",   bench_m1_service_ramp,    prepareRamp,     nullptr },
+    { "m1_update_cruise",  bench_m1_update_cruise,   prepareCruise,   nullptr },
+    { "m1_update_jog",     bench_m1_update_jog,      prepareJog,      finishJog },
+    { "m2_factor_ramp",    bench_m2_factor_ramp,     prepareProfile2, nullptr },
+    { "m2_factor_ramp_trapezoid", bench_m2_factor_ramp_trapezoid, prepareProfile2, nullptr },
+    { "m2_factor_ramp_scurve",    bench_m2_factor_ramp_scurve,    prepareProfile2, nullptr },
+    { "estop_poll",        bench_estop_poll,         nullptr,         nullptr },
+    { "trace_record_idle", bench_trace_record_idle,  nullptr,         nullptr },
+    { "cmd_char",          bench_cmd_char,           prepareChar,     finishChar },
+    { "cmd_mode",          bench_cmd_mode,           prepareMode,     nullptr },
+    { "cmd_deg",           bench_cmd_deg,            prepareDeg,      nullptr },
+    { "cmd_unknown",       bench_cmd_unknown,        prepareUnknown,  nullptr },
+    { "homing_poll",       bench_homing_poll,        prepareHoming,   nullptr },
+};
+
+// === Cycle counter ===
+
+void startCounters() {
+    TIMSK4 = 0;
+    TIMSK5 = 0;
+    TCCR4A = 0;
+    TCCR4B = _BV(CS42) | _BV(CS40);    // clk/1024: wrap counter
+    TCCR5A = 0;
+    TCCR5B = _BV(CS50);                // clk/1: exact cycles mod 65536
+}
+
+// Not inlined: every benchmark is reached through the same indirect call
+__attribute__((noinline, noclone)) uint32_t measure(void (*fn)()) {
+    uint8_t sreg = SREG;
+    cli();
+    TCNT4 = 0;
+    TCNT5 = 0;
+    fn();
+    uint16_t fine = TCNT5;
+    uint16_t coarse = TCNT4;
+    SREG = sreg;
+
+    // coarse * 1024 is within ~2048 cycles of the truth: it picks the wrap count
+    int32_t approx = (int32_t)coarse * 1024 - (int32_t)fine;
+    uint32_t wraps = (approx > 0) ? (uint32_t)(approx + 32768) / 65536UL : 0;
+    return wraps * 65536UL + fine;
+}
+
+void setup() {
+    Serial.begin(Config::Serial::BAUD_RATE);
+    motor1.init();
+    eStop.init();
+    startCounters();
+
+    Serial.print(F("BENCH_INFO f_cpu "));
+    Serial.println(F_CPU);
+
+    uint32_t overhead = measure(bench_empty);
+    uint8_t count = 0;
+    for (const Benchmark& b : BENCHMARKS) {
+        if (b.prepare) b.prepare();
+        Serial.flush();     // Empty TX buffer: command output never blocks
+        uint32_t cycles = measure(b.run) - overhead;
+        if (b.finish) b.finish();
+
+        Serial.print(F("BENCH "));
+        Serial.print(b.name);
+        Serial.print(' ');
+        Serial.println(cycles);
+        count++;
+    }
+    Serial.print(F("BENCH_DONE "));
+    Serial.println(count);
+    Serial.flush();
+
+    // Sleeping with interrupts off ends the simavr run
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+}
+
+void loop() {}
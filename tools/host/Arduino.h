@@ -0,0 +1,168 @@
+/**
+ * Host shim for the subset of the Arduino API used by the firmware headers.
+ *
+ * Lets the real include/ classes compile and run on Linux for the tools
+ * in tools/. Time is simulated (see HostSim.h): delay() and
+ * delayMicroseconds() advance the simulated clock instead of sleeping.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <type_traits>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+template <typename A, typename B>
+inline typename std::common_type<A, B>::type min(A a, B b) { return (a < b) ? a : b; }
+template <typename A, typename B>
+inline typename std::common_type<A, B>::type max(A a, B b) { return (a > b) ? a : b; }
+
+// Flash strings are plain strings on the host
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+
+// === Pins ===
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// === Time ===
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// === Interrupts ===
+#define noInterrupts() ((void)0)
+#define interrupts() ((void)0)
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+#define NOT_AN_INTERRUPT -1
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+// Timer0 compare A: HostSim calls the vector at every Timer0 tick while
+// OCIE0A is set in TIMSK0 (OCR0A only sets the phase on the MCU)
+#define _BV(bit) (1 << (bit))
+#define OCIE0A 1
+extern volatile uint8_t OCR0A;
+extern volatile uint8_t TIMSK0;
+#define TIMER0_COMPA_vect HostSim_timer0CompA
+#define ISR(vector) extern "C" void vector()
+
+// === String ===
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& str) : s(str) {}
+
+    void reserve(unsigned int n) { s.reserve(n); }
+    unsigned int length() const { return (unsigned int)s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    String& operator=(const char* c) { s = c ? c : ""; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    String& operator+=(const char* c) { s += c; return *this; }
+    String& operator+=(const String& o) { s += o.s; return *this; }
+
+    bool operator==(const char* c) const { return s == c; }
+    bool operator!=(const char* c) const { return s != c; }
+    bool operator==(const String& o) const { return s == o.s; }
+
+    bool startsWith(const char* prefix) const { return s.compare(0, strlen(prefix), prefix) == 0; }
+    String substring(unsigned int from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from >= s.size() || to <= from) return String();
+        return String(s.substr(from, to - from));
+    }
+    int indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+
+    void trim() {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        size_t e = s.find_last_not_of(" \t\r\n");
+        s = (b == std::string::npos) ? std::string() : s.substr(b, e - b + 1);
+    }
+    void toLowerCase() { for (char& c : s) c = (char)tolower((unsigned char)c); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    long toInt() const { return atol(s.c_str()); }
+};
+
+// === Serial ===
+// RX side mirrors the AVR core: a ring buffer filled by _rx_complete_irq()
+#define SERIAL_RX_BUFFER_SIZE 64
+typedef uint8_t rx_buffer_index_t;
+
+class HardwareSerial {
+private:
+    std::string line;
+    void emit(const char* text, size_t len);
+    void emit(const char* text) { emit(text, strlen(text)); }
+
+protected:
+    volatile rx_buffer_index_t _rx_buffer_head = 0;
+    volatile rx_buffer_index_t _rx_buffer_tail = 0;
+    unsigned char _rx_buffer[SERIAL_RX_BUFFER_SIZE] = {};
+
+public:
+    void _rx_complete_irq(uint8_t c);
+
+    void begin(unsigned long) {}
+    int available();
+    int read();
+    int peek();
+    void flush() {}
+    size_t write(uint8_t b);
+    size_t write(const uint8_t* buf, size_t n) { for (size_t i = 0; i < n; i++) write(buf[i]); return n; }
+
+    void print(const char* v) { emit(v); }
+    void print(const __FlashStringHelper* v) { emit(reinterpret_cast<const char*>(v)); }
+    void print(const String& v) { emit(v.c_str()); }
+    void print(char v) { char b[2] = { v, 0 }; emit(b); }
+    void print(int v, int base = DEC) { print((long)v, base); }
+    void print(unsigned int v, int base = DEC) { print((unsigned long)v, base); }
+    void print(long v, int base = DEC);
+    void print(unsigned long v, int base = DEC);
+    void print(double v, int digits = 2);
+
+    template <typename T> void println(const T& v) { print(v); emit("\r\n"); }
+    template <typename T> void println(const T& v, int fmt) { print(v, fmt); emit("\r\n"); }
+    void println() { emit("\r\n"); }
+
+    explicit operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
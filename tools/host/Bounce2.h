@@ -0,0 +1,26 @@
+// Host shim: Bounce2 without debouncing (simulated inputs are clean)
+
+#ifndef HOST_BOUNCE2_H
+#define HOST_BOUNCE2_H
+
+#include "Arduino.h"
+
+class Bounce {
+private:
+    uint8_t pin;
+    uint8_t state;
+
+public:
+    Bounce() : pin(0), state(HIGH) {}
+    void attach(int p) { pin = (uint8_t)p; state = (uint8_t)digitalRead(pin); }
+    void interval(uint16_t) {}
+    bool update() {
+        uint8_t s = (uint8_t)digitalRead(pin);
+        bool changed = s != state;
+        state = s;
+        return changed;
+    }
+    int read() const { return state; }
+};
+
+#endif // HOST_BOUNCE2_H
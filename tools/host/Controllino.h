@@ -0,0 +1,13 @@
+// Host shim: Controllino MAXI Automation pin names used by the firmware
+
+#ifndef HOST_CONTROLLINO_H
+#define HOST_CONTROLLINO_H
+
+#define CONTROLLINO_DI0 66
+#define CONTROLLINO_DI1 67
+#define CONTROLLINO_DI2 10
+#define CONTROLLINO_DI3 11
+#define CONTROLLINO_IN0 18
+#define CONTROLLINO_IN1 19
+
+#endif // HOST_CONTROLLINO_H
@@ -0,0 +1,34 @@
+// Host shim: EEPROM as a RAM array, erased (0xFF) by HostSim::reset()
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+#include <string.h>
+
+class EEPROMClass {
+public:
+    static const uint16_t SIZE = 4096;     // ATmega2560
+    uint8_t data[SIZE];
+
+    EEPROMClass() { erase(); }
+    void erase() { memset(data, 0xFF, sizeof(data)); }
+
+    uint8_t read(int address) const { return data[address]; }
+    void write(int address, uint8_t value) { data[address] = value; }
+    void update(int address, uint8_t value) { data[address] = value; }
+    uint16_t length() const { return SIZE; }
+
+    template <typename T> T& get(int address, T& value) const {
+        memcpy(&value, &data[address], sizeof(T));
+        return value;
+    }
+    template <typename T> const T& put(int address, const T& value) {
+        memcpy(&data[address], &value, sizeof(T));
+        return value;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,192 @@
+#include "Arduino.h"
+#include "HostSim.h"
+#include "TimerOne.h"
+#include "TimerThree.h"
+#include "EEPROM.h"
+
+HardwareSerial Serial;
+TimerOneShim Timer1;
+TimerThreeShim Timer3;
+EEPROMClass EEPROM;
+volatile uint8_t OCR0A = 0;
+volatile uint8_t TIMSK0 = 0;
+
+// Defined by the firmware with ISR(TIMER0_COMPA_vect); absent in other tools
+extern "C" void HostSim_timer0CompA() __attribute__((weak));
+
+namespace {
+    const uint8_t PIN_COUNT = 100;
+    const uint64_t TIMER0_TICK_US = 1024;      // millis() interrupt period on the MCU
+
+    uint64_t clockUs = 0;
+    uint64_t nextTickUs = TIMER0_TICK_US;
+    uint64_t sleepUs = 0;
+    HostSim::Timer timers[2];
+    uint8_t pinLevels[PIN_COUNT];
+    HostSim::PinWriteHook pinHook = nullptr;
+    FILE* serialOut = stdout;
+    HostSim::LineHook lineHook = nullptr;
+
+    void (*externalIsr[8])() = {};
+
+    void timer0Tick() {
+        if ((TIMSK0 & _BV(OCIE0A)) && HostSim_timer0CompA) HostSim_timer0CompA();
+    }
+
+    HostSim::Timer* nextDueTimer(uint64_t until) {
+        HostSim::Timer* due = nullptr;
+        for (HostSim::Timer& t : timers) {
+            if (!t.running || !t.isr || t.nextFire > until) continue;
+            if (!due || t.nextFire < due->nextFire) due = &t;
+        }
+        return due;
+    }
+}
+
+namespace HostSim {
+    void reset() {
+        clockUs = 0;
+        nextTickUs = TIMER0_TICK_US;
+        TIMSK0 = 0;
+        sleepUs = 0;
+        for (Timer& t : timers) t = Timer{ nullptr, 0, false, 0, 0 };
+        for (uint8_t& p : pinLevels) p = HIGH;
+        pinHook = nullptr;
+        lineHook = nullptr;
+        serialOut = stdout;
+        while (Serial.available()) Serial.read();
+        for (auto& isr : externalIsr) isr = nullptr;
+        EEPROM.erase();
+    }
+
+    uint64_t now() { return clockUs; }
+
+    void advance(uint64_t us, bool yieldBetween) {
+        uint64_t until = clockUs + us;
+        if (yieldBetween) yield();      // The core's delay() loop yields before it first waits
+        while (true) {
+            if (Timer* t = nextDueTimer(min(nextTickUs, until))) {
+                clockUs = t->nextFire;
+                t->nextFire += t->periodUs;
+                t->fireCount++;
+                t->isr();
+                if (yieldBetween) yield();
+            } else if (nextTickUs <= until) {
+                // Timer0 compare vector; delay() keeps calling yield() with no
+                // ISR firing, modelled once per millis tick
+                clockUs = nextTickUs;
+                nextTickUs += TIMER0_TICK_US;
+                timer0Tick();
+                if (yieldBetween) yield();
+            } else {
+                break;
+            }
+        }
+        clockUs = until;
+    }
+
+    void sleep() {
+        uint64_t wake = nextTickUs;
+        if (Timer* t = nextDueTimer(wake)) wake = t->nextFire;
+        sleepUs += wake - clockUs;
+        advance(wake - clockUs);
+    }
+
+    uint64_t sleptUs() { return sleepUs; }
+
+    Timer& timer(uint8_t n) { return timers[n == 3 ? 1 : 0]; }
+
+    uint8_t pinLevel(uint8_t pin) { return pin < PIN_COUNT ? pinLevels[pin] : LOW; }
+    void setInputLevel(uint8_t pin, uint8_t level) { if (pin < PIN_COUNT) pinLevels[pin] = level; }
+    void setPinWriteHook(PinWriteHook hook) { pinHook = hook; }
+
+    void setSerialOutput(FILE* out) { serialOut = out; }
+    void setLineHook(LineHook hook) { lineHook = hook; }
+    void feedSerial(const char* text) { while (*text) Serial._rx_complete_irq((uint8_t)*text++); }
+}
+
+// === Arduino API ===
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < PIN_COUNT) pinLevels[pin] = val ? HIGH : LOW;
+    if (pinHook) pinHook(pin, val ? HIGH : LOW);
+}
+
+int digitalRead(uint8_t pin) { return HostSim::pinLevel(pin); }
+
+unsigned long millis() { return (unsigned long)(clockUs / 1000); }
+unsigned long micros() { return (unsigned long)clockUs; }
+
+void delay(unsigned long ms) {
+    // Same shape as the AVR core: yield() keeps running while we wait
+    HostSim::advance((uint64_t)ms * 1000, true);
+    yield();
+}
+
+void delayMicroseconds(unsigned int us) { HostSim::advance(us); }
+
+__attribute__((weak)) void yield() {}
+
+int digitalPinToInterrupt(uint8_t pin) { return pin < 8 ? pin : NOT_AN_INTERRUPT; }
+void attachInterrupt(uint8_t n, void (*isr)(), int) { if (n < 8) externalIsr[n] = isr; }
+void detachInterrupt(uint8_t n) { if (n < 8) externalIsr[n] = nullptr; }
+
+// === Serial ===
+
+void HardwareSerial::emit(const char* text, size_t len) {
+    if (serialOut) fwrite(text, 1, len, serialOut);
+    if (!lineHook) return;
+    for (const char* c = text; c < text + len; c++) {
+        if (*c == '\n') {
+            lineHook(line.c_str());
+            line.clear();
+        } else if (*c != '\r') {
+            line += *c;
+        }
+    }
+}
+
+void HardwareSerial::_rx_complete_irq(uint8_t c) {
+    rx_buffer_index_t i = (rx_buffer_index_t)(_rx_buffer_head + 1) % SERIAL_RX_BUFFER_SIZE;
+    if (i == _rx_buffer_tail) return;   // Overflow: byte dropped, as on the MCU
+    _rx_buffer[_rx_buffer_head] = c;
+    _rx_buffer_head = i;
+}
+
+int HardwareSerial::available() {
+    return ((unsigned int)(SERIAL_RX_BUFFER_SIZE + _rx_buffer_head - _rx_buffer_tail)) % SERIAL_RX_BUFFER_SIZE;
+}
+
+int HardwareSerial::read() {
+    if (_rx_buffer_head == _rx_buffer_tail) return -1;
+    unsigned char c = _rx_buffer[_rx_buffer_tail];
+    _rx_buffer_tail = (rx_buffer_index_t)(_rx_buffer_tail + 1) % SERIAL_RX_BUFFER_SIZE;
+    return c;
+}
+
+int HardwareSerial::peek() { return _rx_buffer_head == _rx_buffer_tail ? -1 : _rx_buffer[_rx_buffer_tail]; }
+
+size_t HardwareSerial::write(uint8_t b) {
+    emit((const char*)&b, 1);
+    return 1;
+}
+
+void HardwareSerial::print(long v, int base) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", v);
+    emit(buf);
+}
+
+void HardwareSerial::print(unsigned long v, int base) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+    emit(buf);
+}
+
+void HardwareSerial::print(double v, int digits) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    emit(buf);
+}
@@ -0,0 +1,61 @@
+/**
+ * Simulated MCU environment behind the host Arduino shim.
+ *
+ * Owns the microsecond clock, the Timer1/Timer3 interrupt sources and the
+ * pin/serial state. Tools drive time forward with advance(); every timer
+ * interrupt that falls due inside the window is fired at its exact time.
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace HostSim {
+    // Periodic interrupt source (TimerOne/TimerThree in ISR mode)
+    struct Timer {
+        void (*isr)();
+        unsigned long periodUs;
+        bool running;
+        uint64_t nextFire;
+        unsigned long fireCount;
+    };
+
+    typedef void (*PinWriteHook)(uint8_t pin, uint8_t level);
+    typedef void (*LineHook)(const char* line);
+
+    // Reset clock, timers, pins and serial buffers
+    void reset();
+
+    // Current simulated time in microseconds
+    uint64_t now();
+
+    // Advance the clock by us, firing due timer ISRs and, at every Timer0
+    // tick (1024 µs), the Timer0 compare A vector if enabled. With
+    // yieldBetween set, yield() runs first, after every ISR and at every
+    // Timer0 tick (models the AVR core's delay() loop).
+    void advance(uint64_t us, bool yieldBetween = false);
+
+    // Idle sleep: advance to the next interrupt, a due step timer or the
+    // Timer0 millis tick (every 1024 µs), and fire it
+    void sleep();
+
+    // Time spent in sleep() since reset()
+    uint64_t sleptUs();
+
+    // Timer access (n = 1 or 3)
+    Timer& timer(uint8_t n);
+
+    // Pins
+    uint8_t pinLevel(uint8_t pin);
+    void setInputLevel(uint8_t pin, uint8_t level);
+    void setPinWriteHook(PinWriteHook hook);
+
+    // Serial: output goes to out (nullptr discards) and/or the line hook
+    void setSerialOutput(FILE* out);
+    void setLineHook(LineHook hook);
+    void feedSerial(const char* text);
+}
+
+#endif // HOST_SIM_H
@@ -0,0 +1,43 @@
+// Host shim: TimerOne driven by the HostSim clock
+
+#ifndef HOST_TIMERONE_H
+#define HOST_TIMERONE_H
+
+#include "Arduino.h"
+#include "HostSim.h"
+
+class TimerOneShim {
+public:
+    void initialize(unsigned long microseconds = 1000000) {
+        setPeriod(microseconds);
+        start();
+    }
+    // Like the library, setPeriod() writes the clock-select bits: it also
+    // starts a stopped timer
+    void setPeriod(unsigned long microseconds) {
+        HostSim::Timer& t = HostSim::timer(1);
+        t.periodUs = microseconds ? microseconds : 1;
+        if (!t.running) {
+            t.running = true;
+            t.nextFire = HostSim::now() + t.periodUs;
+        }
+    }
+    void attachInterrupt(void (*isr)()) { HostSim::timer(1).isr = isr; }
+    void attachInterrupt(void (*isr)(), unsigned long microseconds) { setPeriod(microseconds); attachInterrupt(isr); }
+    void detachInterrupt() { HostSim::timer(1).isr = nullptr; }
+    void start() {
+        HostSim::Timer& t = HostSim::timer(1);
+        t.running = true;
+        t.nextFire = HostSim::now() + t.periodUs;
+    }
+    void resume() {
+        HostSim::Timer& t = HostSim::timer(1);
+        if (!t.running) t.nextFire = HostSim::now() + t.periodUs;
+        t.running = true;
+    }
+    void stop() { HostSim::timer(1).running = false; }
+};
+
+extern TimerOneShim Timer1;
+
+#endif // HOST_TIMERONE_H
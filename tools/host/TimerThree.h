@@ -0,0 +1,43 @@
+// Host shim: TimerThree driven by the HostSim clock
+
+#ifndef HOST_TIMERTHREE_H
+#define HOST_TIMERTHREE_H
+
+#include "Arduino.h"
+#include "HostSim.h"
+
+class TimerThreeShim {
+public:
+    void initialize(unsigned long microseconds = 1000000) {
+        setPeriod(microseconds);
+        start();
+    }
+    // Like the library, setPeriod() writes the clock-select bits: it also
+    // starts a stopped timer
+    void setPeriod(unsigned long microseconds) {
+        HostSim::Timer& t = HostSim::timer(3);
+        t.periodUs = microseconds ? microseconds : 1;
+        if (!t.running) {
+            t.running = true;
+            t.nextFire = HostSim::now() + t.periodUs;
+        }
+    }
+    void attachInterrupt(void (*isr)()) { HostSim::timer(3).isr = isr; }
+    void attachInterrupt(void (*isr)(), unsigned long microseconds) { setPeriod(microseconds); attachInterrupt(isr); }
+    void detachInterrupt() { HostSim::timer(3).isr = nullptr; }
+    void start() {
+        HostSim::Timer& t = HostSim::timer(3);
+        t.running = true;
+        t.nextFire = HostSim::now() + t.periodUs;
+    }
+    void resume() {
+        HostSim::Timer& t = HostSim::timer(3);
+        if (!t.running) t.nextFire = HostSim::now() + t.periodUs;
+        t.running = true;
+    }
+    void stop() { HostSim::timer(3).running = false; }
+};
+
+extern TimerThreeShim Timer3;
+
+#endif // HOST_TIMERTHREE_H
@@ -0,0 +1,16 @@
+// Host shim: avr/sleep.h, sleep_cpu() advances the HostSim clock to the next interrupt
+
+#ifndef HOST_AVR_SLEEP_H
+#define HOST_AVR_SLEEP_H
+
+#include "../HostSim.h"
+
+#define SLEEP_MODE_IDLE     0
+#define SLEEP_MODE_PWR_DOWN 2
+
+inline void set_sleep_mode(uint8_t) {}
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_cpu() { HostSim::sleep(); }
+
+#endif // HOST_AVR_SLEEP_H
@@ -0,0 +1,16 @@
+// Host shim: avr-libc <util/crc16.h> (CRC-16, polynomial 0xA001)
+
+#ifndef HOST_UTIL_CRC16_H
+#define HOST_UTIL_CRC16_H
+
+#include <stdint.h>
+
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t data) {
+    crc ^= data;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+#endif // HOST_UTIL_CRC16_H
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Per-class memory usage report with budget check.
+
+Parses the firmware ELF symbol table and attributes .text/.data/.bss to
+classes: member functions by their "Class::" prefix, vtables by name, and
+global instances (motor1, Serial, ...) via the "instances" map in the
+budget file. Fails when a total or per-class budget is exceeded.
+
+PlatformIO runs this after linking (extra_scripts = post:tools/memory_budget.py).
+Standalone:
+
+    python3 tools/memory_budget.py .pio/build/<env>/firmware.elf \\
+        [--budget tools/memory_budget.json] [--nm avr-nm] [--size avr-size]
+"""
+
+import argparse
+import collections
+import json
+import os
+import re
+import subprocess
+import sys
+
+FLASH_SECTIONS = (".text",)
+DATA_SECTIONS = (".data",)
+BSS_SECTIONS = (".bss", ".noinit")
+
+SYMBOL_PREFIXES = ("vtable for ", "VTT for ", "typeinfo for ", "typeinfo name for ",
+                   "guard variable for ", "construction vtable for ")
+
+CLASS_RE = re.compile(r"^(?:[A-Za-z_]\w*::)*?([A-Za-z_]\w*)(?:<.*?>)?::[~A-Za-z_]")   # Templates by class name
+
+
+def owner_of(name, instances):
+    if name in instances:
+        return instances[name]
+    for prefix in SYMBOL_PREFIXES:
+        if name.startswith(prefix):
+            return name[len(prefix):].split("<")[0]
+    m = CLASS_RE.match(name)
+    if m:
+        return m.group(1)
+    return "(unattributed)"
+
+
+def read_symbols(nm, elf):
+    """Yield (name, section, size) using the SysV table (has section names)."""
+    out = subprocess.run([nm, "-C", "--format=sysv", elf], check=True,
+                         capture_output=True, text=True).stdout
+    for line in out.splitlines():
+        fields = [f.strip() for f in line.split("|")]
+        if len(fields) < 7 or not fields[4]:
+            continue
+        try:
+            size = int(fields[4], 16)
+        except ValueError:
+            continue
+        yield fields[0], fields[6], size
+
+
+def read_section_totals(size_tool, elf):
+    out = subprocess.run([size_tool, "-A", elf], check=True,
+                         capture_output=True, text=True).stdout
+    totals = collections.Counter()
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            totals[parts[0]] += int(parts[1])
+    return totals
+
+
+def usage_by_class(symbols, instances):
+    usage = collections.defaultdict(collections.Counter)
+    for name, section, size in symbols:
+        cls = owner_of(name, instances)
+        if section in FLASH_SECTIONS:
+            usage[cls]["text"] += size
+        elif section in DATA_SECTIONS:
+            usage[cls]["data"] += size
+        elif section in BSS_SECTIONS:
+            usage[cls]["bss"] += size
+    for u in usage.values():
+        u["flash"] = u["text"] + u["data"]
+        u["ram"] = u["data"] + u["bss"]
+    return usage
+
+
+def check(elf, budget_path, nm, size_tool, out=sys.stdout):
+    with open(budget_path) as f:
+        budget = json.load(f)
+    instances = budget.get("instances", {})
+    usage = usage_by_class(read_symbols(nm, elf), instances)
+    sections = read_section_totals(size_tool, elf)
+
+    flash_total = sum(sections[s] for s in FLASH_SECTIONS + DATA_SECTIONS)
+    ram_total = sum(sections[s] for s in DATA_SECTIONS + BSS_SECTIONS)
+
+    failures = []
+
+    def over(what, value, limit):
+        if limit is not None and value > limit:
+            failures.append("%s: %d bytes exceeds budget of %d" % (what, value, limit))
+            return " OVER %d" % limit
+        return ""
+
+    print("%-24s %7s %7s %7s %7s %7s" % ("class", "text", ".data", ".bss", "flash", "ram"), file=out)
+    classes = budget.get("classes", {})
+    ordered = sorted(usage, key=lambda c: (c not in classes, -usage[c]["flash"]))
+    for cls in ordered:
+        u = usage[cls]
+        limits = classes.get(cls, {})
+        flag = over(cls + " flash", u["flash"], limits.get("flash"))
+        flag += over(cls + " ram", u["ram"], limits.get("ram"))
+        flag += over(cls + " .data", u["data"], limits.get("data"))
+        flag += over(cls + " .bss", u["bss"], limits.get("bss"))
+        print("%-24s %7d %7d %7d %7d %7d%s" % (cls, u["text"], u["data"], u["bss"],
+                                               u["flash"], u["ram"], flag), file=out)
+
+    totals = budget.get("totals", {})
+    print("%-24s %7d %7d %7d %7d %7d%s" % (
+        "TOTAL", sections[".text"], sections[".data"],
+        sum(sections[s] for s in BSS_SECTIONS), flash_total, ram_total,
+        over("total flash", flash_total, totals.get("flash"))
+        + over("total ram", ram_total, totals.get("ram"))), file=out)
+
+    for fail in failures:
+        print("Memory budget exceeded - " + fail, file=out)
+    return 1 if failures else 0
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--budget", default=os.path.join(here, "memory_budget.json"))
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--size", default="avr-size")
+    args = parser.parse_args()
+    return check(args.elf, args.budget, args.nm, args.size)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+except NameError:
+    env = None
+
+if env is not None:
+    def _post_link(source, target, env):
+        budget = os.path.join(env.subst("$PROJECT_DIR"),
+                              env.GetProjectOption("custom_memory_budget", "tools/memory_budget.json"))
+        nm = env.subst("$CC").replace("gcc", "nm")
+        return check(str(target[0]), budget, nm, env.subst("$SIZETOOL"))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _post_link)
+elif __name__ == "__main__":
+    sys.exit(main())
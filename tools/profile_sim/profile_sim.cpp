@@ -0,0 +1,219 @@
+/**
+ * Speed profile update strategy comparison (host simulation)
+ *
+ * Runs the real MainMotor/OscillationMotor profile code against a simulated
+ * step timer and compares three ways of serving profile updates:
+ *
+ *   reference   - update after every step, zero latency (ideal curve)
+ *   wall-clock  - update every N ms from loop() (the old behaviour)
+ *   step-K      - ISR requests an update every PROFILE_UPDATE_STEPS steps,
+ *                 served after a bounded latency (current firmware)
+ *
+ * Velocity error is measured per step against the reference curve and
+ * reported as a fraction of cruise speed.
+ *
+ * Usage: profile_sim [--latency-us N] [--wall-ms N] [--range-deg D] [--csv FILE]
+ */
+
+#include <Arduino.h>
+#include "HostSim.h"
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+
+#include <vector>
+
+namespace {
+
+enum class Strategy { REFERENCE, WALL_CLOCK, STEP_TRIGGERED };
+
+struct Options {
+    unsigned long latencyUs = 20;   // Request -> service delay (yield() polling)
+    unsigned long wallMs = 10;      // Old loop() update interval
+    float rangeDeg = 180.0f;        // Motor2 distance between limit switches
+    const char* csvPath = nullptr;
+};
+
+struct Run {
+    std::vector<uint64_t> stepTimes;   // Completion time of each step (µs)
+    unsigned long updates = 0;
+};
+
+struct Stats {
+    double rmsError = 0;     // RMS velocity error vs reference (fraction of cruise)
+    double maxError = 0;     // Worst single-step velocity error
+    double maxJump = 0;      // Largest step-to-step velocity jump (ramp resolution)
+    double durationMs = 0;
+};
+
+const uint64_t NEVER = ~0ULL;
+
+// Drive one move to completion under the given update strategy
+template <typename Motor>
+Run simulate(Motor& motor, Strategy strategy, const Options& opt) {
+    Run run;
+    const float basePeriod = (float)motor.getTimerPeriod();
+    uint64_t t = HostSim::now();
+    uint64_t lastIsr = t;
+    unsigned long period = 0;
+    uint64_t nextService = NEVER;
+
+    auto update = [&]() {
+        motor.takeProfileUpdateRequest();
+        float factor = motor.updateSpeedProfile();
+        period = (unsigned long)(basePeriod / factor);
+        run.updates++;
+    };
+
+    // Every strategy sets the starting speed when the move begins
+    update();
+    if (strategy == Strategy::WALL_CLOCK) nextService = t + opt.wallMs * 1000UL;
+
+    while (motor.isEnabled()) {
+        uint64_t nextIsr = lastIsr + period;
+        if (nextService < nextIsr) {
+            t = nextService;
+            if (strategy == Strategy::WALL_CLOCK) {
+                update();
+                nextService = t + opt.wallMs * 1000UL;
+            } else {
+                update();
+                nextService = NEVER;
+            }
+            continue;
+        }
+
+        t = lastIsr = nextIsr;
+        unsigned long before = motor.getStepCount();
+        motor.step();
+        if (motor.getStepCount() == before) continue;
+        run.stepTimes.push_back(t);
+
+        if (strategy == Strategy::REFERENCE) {
+            update();
+        } else if (strategy == Strategy::STEP_TRIGGERED && nextService == NEVER
+                   && motor.takeProfileUpdateRequest()) {
+            nextService = t + opt.latencyUs;
+        }
+    }
+    return run;
+}
+
+Stats compare(const Run& run, const Run& ref, float stepFreq) {
+    Stats s;
+    size_t n = min(run.stepTimes.size(), ref.stepTimes.size());
+    double sumSq = 0;
+    double prevV = 0;
+    for (size_t i = 1; i < n; i++) {
+        double v = 1e6 / (double)(run.stepTimes[i] - run.stepTimes[i - 1]);
+        double vRef = 1e6 / (double)(ref.stepTimes[i] - ref.stepTimes[i - 1]);
+        double err = fabs(v - vRef) / stepFreq;
+        sumSq += err * err;
+        s.maxError = max(s.maxError, err);
+        if (i > 1) s.maxJump = max(s.maxJump, fabs(v - prevV) / stepFreq);
+        prevV = v;
+    }
+    s.rmsError = n > 1 ? sqrt(sumSq / (double)(n - 1)) : 0;
+    s.durationMs = run.stepTimes.empty() ? 0 : (run.stepTimes.back() - run.stepTimes.front()) / 1000.0;
+    return s;
+}
+
+// Run the real homing state machine against simulated limit switches
+void homeMotor2(OscillationMotor& motor2, unsigned long rangeSteps) {
+    motor2.init();
+    motor2.startHoming();
+    while (!motor2.isHomingComplete()) {
+        HomingState st = motor2.getHomingState();
+        bool leftHit = st == HomingState::MOVE_LEFT && motor2.isEnabled();
+        bool rightHit = st == HomingState::MOVE_RIGHT && motor2.isEnabled()
+                        && motor2.getStepCount() >= rangeSteps;
+        HostSim::setInputLevel(Config::Motor2::LEFT_SWITCH_PIN, leftHit ? LOW : HIGH);
+        HostSim::setInputLevel(Config::Motor2::RIGHT_SWITCH_PIN, rightHit ? LOW : HIGH);
+        motor2.updateSwitches();
+        motor2.updateHoming();
+        if (motor2.isEnabled()) motor2.step();
+    }
+}
+
+Run runMotor1(Strategy strategy, const Options& opt) {
+    HostSim::reset();
+    HostSim::setSerialOutput(nullptr);
+    MainMotor motor1;
+    motor1.init();
+    motor1.startMovement(Config::Motor1::SEQUENCE_DEGREES);
+    return simulate(motor1, strategy, opt);
+}
+
+Run runMotor2(Strategy strategy, const Options& opt) {
+    HostSim::reset();
+    HostSim::setSerialOutput(nullptr);
+    OscillationMotor motor2;
+    unsigned long rangeSteps = (unsigned long)(opt.rangeDeg / 360.0f * Config::Motor2::GEAR_RATIO
+                                               * Config::Motor2::STEPS_PER_REV * Config::Motor2::MICROSTEPS);
+    homeMotor2(motor2, rangeSteps);
+    motor2.startOscillation(false);
+    return simulate(motor2, strategy, opt);
+}
+
+void writeCsv(FILE* f, const char* axis, const char* strategy, const Run& run) {
+    for (size_t i = 1; i < run.stepTimes.size(); i++) {
+        fprintf(f, "%s,%s,%zu,%llu,%.1f\n", axis, strategy, i,
+                (unsigned long long)run.stepTimes[i],
+                1e6 / (double)(run.stepTimes[i] - run.stepTimes[i - 1]));
+    }
+}
+
+void report(const char* axis, float stepFreq, uint8_t k, Run (*runAxis)(Strategy, const Options&),
+            const Options& opt, FILE* csv) {
+    Run ref = runAxis(Strategy::REFERENCE, opt);
+    Run wall = runAxis(Strategy::WALL_CLOCK, opt);
+    Run stepK = runAxis(Strategy::STEP_TRIGGERED, opt);
+
+    char wallName[24], stepName[24];
+    snprintf(wallName, sizeof(wallName), "wall-clock-%lums", opt.wallMs);
+    snprintf(stepName, sizeof(stepName), "step-K%u", k);
+
+    const Run* runs[] = { &ref, &wall, &stepK };
+    const char* names[] = { "reference", wallName, stepName };
+    for (int i = 0; i < 3; i++) {
+        Stats s = compare(*runs[i], ref, stepFreq);
+        printf("%-8s %-18s %8lu %8zu %10.1f %9.3f %9.3f %9.3f\n", axis, names[i],
+               runs[i]->updates, runs[i]->stepTimes.size(), s.durationMs,
+               s.rmsError * 100, s.maxError * 100, s.maxJump * 100);
+        if (csv) writeCsv(csv, axis, names[i], *runs[i]);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--latency-us") && i + 1 < argc) opt.latencyUs = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--wall-ms") && i + 1 < argc) opt.wallMs = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--range-deg") && i + 1 < argc) opt.rangeDeg = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) opt.csvPath = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--latency-us N] [--wall-ms N] [--range-deg D] [--csv FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FILE* csv = nullptr;
+    if (opt.csvPath) {
+        csv = fopen(opt.csvPath, "w");
+        if (!csv) { perror(opt.csvPath); return 1; }
+        fprintf(csv, "axis,strategy,step,time_us,velocity_sps\n");
+    }
+
+    printf("Velocity error vs reference (%% of cruise speed), service latency %lu us\n\n", opt.latencyUs);
+    printf("%-8s %-18s %8s %8s %10s %9s %9s %9s\n",
+           "axis", "strategy", "updates", "steps", "time_ms", "rms_err%", "max_err%", "max_jump%");
+
+    MainMotor m1;
+    OscillationMotor m2;
+    report("Motor1", m1.getStepFreq(), Config::Motor1::PROFILE_UPDATE_STEPS, runMotor1, opt, csv);
+    report("Motor2", m2.getStepFreq(), Config::Motor2::PROFILE_UPDATE_STEPS, runMotor2, opt, csv);
+
+    if (csv) fclose(csv);
+    return 0;
+}
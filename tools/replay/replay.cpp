@@ -0,0 +1,626 @@
+/**
+ * Deterministic record/replay regression harness (host simulation)
+ *
+ * Runs the real setup()/loop() from src/fairfanpio.cpp against the HostSim
+ * clock, replays a timestamped script of serial input and switch events, and
+ * records every step edge, direction change and serial line. The recording is
+ * compared with a golden trace stored next to the scenario, with a timing
+ * tolerance per axis. Each scenario runs in its own forked process, so the
+ * firmware globals start fresh every time and scenarios run in parallel.
+ *
+ * Scenario files (*.scn), one directive per line, '#' starts a comment:
+ *
+ *   axis2 <start> <right>        Motor2 position model: left switch closes at
+ *                                step 0, right switch at <right>; Motor2 starts
+ *                                at <start>. Without it switches only change
+ *                                through 'switch' events.
+ *   tolerance m1|m2|log <us>     Allowed timing deviation (default 100 µs for
+ *                                the axes, 20 ms for log lines)
+ *   at <ms> serial <text>        Send <text> plus newline
+ *   at <ms> estop                Send the emergency stop byte
+ *   at <ms> switch left|right press|release
+ *   end <ms>                     Simulated run length
+ *
+ * Events are applied between loop() passes, as the MCU would see them.
+ *
+ * Independent of the golden trace, every run also checks that each Motor2
+ * step pulse comes at least Config::Power::DRIVER_WAKE_US after the driver
+ * was enabled (ENABLE_PIN LOW), and never while it is disabled.
+ *
+ * Golden traces (*.golden) are text: "L <us> <line>" for serial output,
+ * "D <axis> <us> <level>" for direction pin changes and
+ * "S <axis> <us> <count> <interval>" for runs of step pulses (rising edges)
+ * at a constant interval.
+ *
+ * Usage: replay [--update] [--out DIR] [-j N] [--repeat N] [--power] [--isr-cycles N]
+ *               [-v] [scenario.scn|dir ...]
+ *
+ *   --update        write the recordings as the new golden traces
+ *   --out DIR       also write every recording to DIR/<name>.trace
+ *   --repeat N      run each scenario N times (determinism and throughput check)
+ *   --power         report step ISR load, CPU sleep and Motor2 driver enable
+ *                   time per scenario, split into idle (no axis enabled) and
+ *                   busy loop() passes
+ *   --isr-cycles N  cycles per step ISR for the load figure (default 150, an
+ *                   estimate: entry/exit plus step_disabled and estop_poll
+ *                   from avrbench)
+ *
+ * The MCU current in the --power report is modelled from datasheet-typical
+ * ATmega2560 figures at 16 MHz / 5 V: 20 mA active, 7 mA in idle sleep.
+ */
+
+#include <Arduino.h>
+#include "HostSim.h"
+#include "Config.h"
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+
+#include <dirent.h>
+#include <stdarg.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+void setup();
+void loop();
+
+extern MainMotor motor1;
+extern OscillationMotor motor2;
+
+namespace {
+
+enum Channel { MOTOR1 = 0, MOTOR2 = 1, LOG = 2 };
+const char* const CHANNEL_NAMES[] = { "m1", "m2", "log" };
+
+struct Event {
+    uint64_t atUs;
+    enum Kind { SERIAL_INPUT, ESTOP, SWITCH } kind;
+    std::string text;
+    uint8_t pin;
+    uint8_t level;
+};
+
+struct Scenario {
+    std::string name;
+    std::string path;
+    std::string goldenPath;
+    std::vector<Event> events;
+    uint64_t endUs = 0;
+    bool axisModel = false;
+    long startPos = 0;
+    long rightPos = 0;
+    unsigned long toleranceUs[3] = { 100, 100, 20000 };
+};
+
+struct LogLine {
+    uint64_t t;
+    std::string text;
+};
+
+struct DirChange {
+    uint8_t axis;
+    uint64_t t;
+    uint8_t level;
+};
+
+struct Recording {
+    std::vector<uint64_t> steps[2];     // Rising edge time of every step pulse
+    std::vector<DirChange> dirs;
+    std::vector<LogLine> log;
+    unsigned long wakeViolations = 0;   // Motor2 pulses sent to a driver not awake
+    uint64_t firstWakeViolation = 0;
+};
+
+// loop() passes split by whether any axis was enabled when the pass started
+enum PowerPhase { IDLE = 0, BUSY = 1 };
+
+struct PowerStats {
+    uint64_t us[2] = {};
+    uint64_t sleptUs[2] = {};
+    unsigned long isrFires[2] = {};
+    uint64_t driverOnUs = 0;    // Motor2 ENABLE_PIN LOW
+};
+
+const double MCU_CLOCK_HZ = 16e6;
+const float MCU_ACTIVE_MA = 20.0f;
+const float MCU_SLEEP_MA = 7.0f;
+
+struct Options {
+    bool update = false;
+    bool verbose = false;
+    bool power = false;
+    unsigned isrCycles = 150;
+    const char* outDir = nullptr;
+    unsigned jobs = 1;
+    unsigned repeat = 1;
+};
+
+const uint8_t STEP_PINS[2] = { Config::Motor1::STEP_PIN, Config::Motor2::STEP_PIN };
+const uint8_t DIR_PINS[2] = { Config::Motor1::DIR_PIN, Config::Motor2::DIR_PIN };
+
+// === Recording (runs inside the forked child) ===
+
+Recording rec;
+PowerStats power;
+const Scenario* running = nullptr;
+uint8_t lastLevel[2][2];    // [axis][step, dir]
+long axis2Pos = 0;
+bool driverEnabled = false;
+uint64_t driverEnabledAt = 0;
+
+void updateAxis2Switches() {
+    // NC switches: pressed = LOW
+    HostSim::setInputLevel(Config::Motor2::LEFT_SWITCH_PIN, axis2Pos <= 0 ? LOW : HIGH);
+    HostSim::setInputLevel(Config::Motor2::RIGHT_SWITCH_PIN, axis2Pos >= running->rightPos ? LOW : HIGH);
+}
+
+void checkDriverAwake() {
+    uint64_t now = HostSim::now();
+    if (driverEnabled && now - driverEnabledAt >= Config::Power::DRIVER_WAKE_US) return;
+    if (rec.wakeViolations++ == 0) rec.firstWakeViolation = now;
+}
+
+void onPinWrite(uint8_t pin, uint8_t level) {
+    if (pin == Config::Motor2::ENABLE_PIN) {
+        if (level == LOW && !driverEnabled) driverEnabledAt = HostSim::now();
+        driverEnabled = (level == LOW);
+        return;
+    }
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        if (pin == STEP_PINS[axis]) {
+            if (level == HIGH && lastLevel[axis][0] == LOW) {
+                rec.steps[axis].push_back(HostSim::now());
+                if (axis == MOTOR2) checkDriverAwake();
+                if (axis == MOTOR2 && running->axisModel) {
+                    // Motor2 is wired inverted: DIR HIGH moves LEFT
+                    axis2Pos += (lastLevel[MOTOR2][1] == HIGH) ? -1 : 1;
+                    updateAxis2Switches();
+                }
+            }
+            lastLevel[axis][0] = level;
+        } else if (pin == DIR_PINS[axis]) {
+            if (level != lastLevel[axis][1]) {
+                rec.dirs.push_back({ axis, HostSim::now(), level });
+            }
+            lastLevel[axis][1] = level;
+        }
+    }
+}
+
+void onLine(const char* line) {
+    rec.log.push_back({ HostSim::now(), line });
+}
+
+void apply(const Event& e) {
+    switch (e.kind) {
+        case Event::SERIAL_INPUT:
+            HostSim::feedSerial((e.text + "\n").c_str());
+            break;
+        case Event::ESTOP: {
+            char stopByte[2] = { (char)Config::EStop::SERIAL_BYTE, 0 };
+            HostSim::feedSerial(stopByte);
+            break;
+        }
+        case Event::SWITCH:
+            HostSim::setInputLevel(e.pin, e.level);
+            break;
+    }
+}
+
+void runScenario(const Scenario& s) {
+    running = &s;
+    HostSim::reset();
+    HostSim::setSerialOutput(nullptr);
+    HostSim::setLineHook(onLine);
+    HostSim::setPinWriteHook(onPinWrite);
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        lastLevel[axis][0] = HostSim::pinLevel(STEP_PINS[axis]);
+        lastLevel[axis][1] = HostSim::pinLevel(DIR_PINS[axis]);
+    }
+    driverEnabled = HostSim::pinLevel(Config::Motor2::ENABLE_PIN) == LOW;
+    driverEnabledAt = 0;
+    if (s.axisModel) {
+        axis2Pos = s.startPos;
+        updateAxis2Switches();
+    }
+
+    setup();
+    size_t next = 0;
+    while (HostSim::now() < s.endUs) {
+        while (next < s.events.size() && s.events[next].atUs <= HostSim::now()) {
+            apply(s.events[next++]);
+        }
+        PowerPhase phase = (motor1.isEnabled() || motor2.isEnabled()) ? BUSY : IDLE;
+        bool driverOn = HostSim::pinLevel(Config::Motor2::ENABLE_PIN) == LOW;
+        uint64_t start = HostSim::now();
+        uint64_t slept = HostSim::sleptUs();
+        unsigned long fires = HostSim::timer(1).fireCount + HostSim::timer(3).fireCount;
+        loop();
+        uint64_t elapsed = HostSim::now() - start;
+        power.us[phase] += elapsed;
+        power.sleptUs[phase] += HostSim::sleptUs() - slept;
+        power.isrFires[phase] += HostSim::timer(1).fireCount + HostSim::timer(3).fireCount - fires;
+        if (driverOn) power.driverOnUs += elapsed;
+    }
+}
+
+// === Trace files ===
+
+bool writeTrace(const char* path, const Scenario& s, const Recording& r) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "# replay trace: %s\n", s.name.c_str());
+    for (const LogLine& l : r.log) {
+        fprintf(f, "L %llu %s\n", (unsigned long long)l.t, l.text.c_str());
+    }
+    for (const DirChange& d : r.dirs) {
+        fprintf(f, "D %u %llu %u\n", d.axis + 1, (unsigned long long)d.t, d.level);
+    }
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        // Run-length: ramps change the interval every PROFILE_UPDATE_STEPS at most
+        const std::vector<uint64_t>& t = r.steps[axis];
+        size_t i = 0;
+        while (i < t.size()) {
+            uint64_t interval = (i + 1 < t.size()) ? t[i + 1] - t[i] : 0;
+            size_t n = 1;
+            while (i + n < t.size() && t[i + n] - t[i + n - 1] == interval) n++;
+            fprintf(f, "S %u %llu %zu %llu\n", axis + 1, (unsigned long long)t[i], n,
+                    (unsigned long long)interval);
+            i += n;
+        }
+    }
+    return fclose(f) == 0;
+}
+
+bool readTrace(const char* path, Recording& r, std::string& error) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        error = std::string("cannot open ") + path + " (run with --update to create it)";
+        return false;
+    }
+    char line[1024];
+    int lineNo = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        lineNo++;
+        line[strcspn(line, "\r\n")] = 0;
+        unsigned axis = 0, level = 0;
+        unsigned long long t = 0, n = 0, interval = 0;
+        int textAt = 0;
+        if (line[0] == '#' || line[0] == 0) {
+            continue;
+        } else if (sscanf(line, "L %llu%n", &t, &textAt) == 1) {
+            const char* text = line + textAt;
+            r.log.push_back({ t, *text == ' ' ? text + 1 : text });   // Keep leading blanks of the line
+        } else if (sscanf(line, "D %u %llu %u", &axis, &t, &level) == 3 && axis >= 1 && axis <= 2) {
+            r.dirs.push_back({ (uint8_t)(axis - 1), t, (uint8_t)level });
+        } else if (sscanf(line, "S %u %llu %llu %llu", &axis, &t, &n, &interval) == 4 && axis >= 1 && axis <= 2) {
+            for (unsigned long long k = 0; k < n; k++) r.steps[axis - 1].push_back(t + k * interval);
+        } else {
+            error = std::string(path) + ":" + std::to_string(lineNo) + ": bad trace line";
+            ok = false;
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+// === Comparison ===
+
+void appendf(std::string& out, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+void appendf(std::string& out, const char* fmt, ...) {
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    out += buf;
+}
+
+uint64_t absDiff(uint64_t a, uint64_t b) { return a > b ? a - b : b - a; }
+
+// Returns the number of problems found; details go to report
+int compare(const Scenario& s, const Recording& actual, const Recording& golden, std::string& report) {
+    int problems = 0;
+
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        const std::vector<uint64_t>& a = actual.steps[axis];
+        const std::vector<uint64_t>& g = golden.steps[axis];
+        unsigned long tol = s.toleranceUs[axis];
+        if (a.size() != g.size()) {
+            appendf(report, "  Motor%u: %zu steps, golden %zu\n", axis + 1, a.size(), g.size());
+            problems++;
+        }
+        size_t common = min(a.size(), g.size());
+        uint64_t worst = 0;
+        size_t worstAt = 0;
+        for (size_t i = 0; i < common; i++) {
+            uint64_t d = absDiff(a[i], g[i]);
+            if (d > worst) { worst = d; worstAt = i; }
+        }
+        if (worst > tol) {
+            size_t first = 0;
+            while (absDiff(a[first], g[first]) <= tol) first++;
+            appendf(report, "  Motor%u: step %zu at %llu us, golden %llu us (tolerance %lu us); worst %llu us at step %zu\n",
+                    axis + 1, first, (unsigned long long)a[first], (unsigned long long)g[first], tol,
+                    (unsigned long long)worst, worstAt);
+            problems++;
+        }
+    }
+
+    size_t common = min(actual.dirs.size(), golden.dirs.size());
+    for (size_t i = 0; i < common; i++) {
+        const DirChange& a = actual.dirs[i];
+        const DirChange& g = golden.dirs[i];
+        if (a.axis != g.axis || a.level != g.level || absDiff(a.t, g.t) > s.toleranceUs[a.axis]) {
+            appendf(report, "  direction change %zu: Motor%u -> %u at %llu us, golden Motor%u -> %u at %llu us\n",
+                    i, a.axis + 1, a.level, (unsigned long long)a.t, g.axis + 1, g.level, (unsigned long long)g.t);
+            problems++;
+            break;
+        }
+    }
+    if (actual.dirs.size() != golden.dirs.size()) {
+        appendf(report, "  %zu direction changes, golden %zu\n", actual.dirs.size(), golden.dirs.size());
+        problems++;
+    }
+
+    common = min(actual.log.size(), golden.log.size());
+    for (size_t i = 0; i < common; i++) {
+        const LogLine& a = actual.log[i];
+        const LogLine& g = golden.log[i];
+        if (a.text != g.text || absDiff(a.t, g.t) > s.toleranceUs[LOG]) {
+            appendf(report, "  log line %zu:\n    got    %llu us: %s\n    golden %llu us: %s\n",
+                    i, (unsigned long long)a.t, a.text.c_str(), (unsigned long long)g.t, g.text.c_str());
+            problems++;
+            break;
+        }
+    }
+    if (actual.log.size() != golden.log.size()) {
+        appendf(report, "  %zu log lines, golden %zu\n", actual.log.size(), golden.log.size());
+        problems++;
+    }
+    return problems;
+}
+
+// === Power report ===
+
+void appendPower(std::string& out, const Options& opt) {
+    const char* const names[2] = { "idle", "busy" };
+    uint64_t totalUs = power.us[IDLE] + power.us[BUSY];
+    for (uint8_t phase = 0; phase < 2; phase++) {
+        if (power.us[phase] == 0) continue;
+        double seconds = power.us[phase] / 1e6;
+        double isrRate = power.isrFires[phase] / seconds;
+        double load = isrRate * opt.isrCycles / MCU_CLOCK_HZ * 100.0;
+        double sleepShare = (double)power.sleptUs[phase] / power.us[phase];
+        double mcuMa = MCU_SLEEP_MA * sleepShare + MCU_ACTIVE_MA * (1.0 - sleepShare);
+        appendf(out, "  power %s: %.1f s, %.0f step ISR/s (~%.1f %% CPU, estimated at %u cycles/ISR), asleep %.1f %%, MCU ~%.1f mA\n",
+                names[phase], seconds, isrRate, load, opt.isrCycles, sleepShare * 100.0, mcuMa);
+    }
+    if (totalUs > 0) {
+        appendf(out, "  power: Motor2 driver enabled %.1f %% of %.1f s\n",
+                100.0 * power.driverOnUs / totalUs, totalUs / 1e6);
+    }
+}
+
+// Child process: run, then write or check the golden trace. Exit code 0 = pass.
+int runChild(const Scenario& s, unsigned run, const Options& opt) {
+    runScenario(s);
+
+    std::string report;
+    int status = 0;
+    if (opt.outDir) {
+        std::string path = std::string(opt.outDir) + "/" + s.name + ".trace";
+        if (!writeTrace(path.c_str(), s, rec)) appendf(report, "  cannot write %s\n", path.c_str());
+    }
+    if (opt.update) {
+        if (run == 0 && !writeTrace(s.goldenPath.c_str(), s, rec)) {
+            appendf(report, "  cannot write %s\n", s.goldenPath.c_str());
+            status = 2;
+        }
+    } else {
+        Recording golden;
+        std::string error;
+        if (!readTrace(s.goldenPath.c_str(), golden, error)) {
+            appendf(report, "  %s\n", error.c_str());
+            status = 2;
+        } else if (compare(s, rec, golden, report)) {
+            status = 1;
+        }
+    }
+
+    if (rec.wakeViolations) {
+        appendf(report, "  Motor2: %lu pulses while the driver was off or within %lu us of enable, first at %llu us\n",
+                rec.wakeViolations, (unsigned long)Config::Power::DRIVER_WAKE_US,
+                (unsigned long long)rec.firstWakeViolation);
+        status = max(status, 1);
+    }
+
+    std::string out;
+    if (status || opt.verbose || opt.power) {
+        appendf(out, "%s %s: %.1f s simulated, %zu + %zu steps, %zu lines\n",
+                status ? "FAIL" : (opt.update ? "REC " : "PASS"), s.name.c_str(), s.endUs / 1e6,
+                rec.steps[0].size(), rec.steps[1].size(), rec.log.size());
+    }
+    out += report;
+    if (opt.power) appendPower(out, opt);
+    fwrite(out.data(), 1, out.size(), stdout);
+    fflush(stdout);
+    return status;
+}
+
+// === Scenario parsing ===
+
+bool parseScenario(const std::string& path, Scenario& s) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", path.c_str());
+        return false;
+    }
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    s.path = path;
+    s.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    s.name = s.name.substr(0, s.name.find_last_of('.'));
+    s.goldenPath = path.substr(0, dot) + ".golden";
+
+    char line[512];
+    int lineNo = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        lineNo++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = 0;
+        line[strcspn(line, "\r\n")] = 0;
+
+        char word[32] = "", arg[32] = "";
+        double ms = 0;
+        long a = 0, b = 0;
+        int rest = 0;
+        if (sscanf(line, " %31s", word) != 1) continue;
+
+        if (!strcmp(word, "axis2") && sscanf(line, " axis2 %ld %ld", &a, &b) == 2 && b > 0) {
+            s.axisModel = true;
+            s.startPos = a;
+            s.rightPos = b;
+        } else if (!strcmp(word, "tolerance") && sscanf(line, " tolerance %31s %ld", arg, &a) == 2 && a >= 0) {
+            ok = false;
+            for (int c = 0; c < 3; c++) {
+                if (!strcmp(arg, CHANNEL_NAMES[c])) { s.toleranceUs[c] = (unsigned long)a; ok = true; }
+            }
+        } else if (!strcmp(word, "end") && sscanf(line, " end %lf", &ms) == 1 && ms > 0) {
+            s.endUs = (uint64_t)(ms * 1000);
+        } else if (!strcmp(word, "at") && sscanf(line, " at %lf %31s %n", &ms, arg, &rest) == 2 && ms >= 0) {
+            Event e = { (uint64_t)(ms * 1000), Event::SERIAL_INPUT, "", 0, 0 };
+            char side[16] = "", action[16] = "";
+            if (!strcmp(arg, "serial") && rest > 0 && line[rest]) {
+                e.text = line + rest;
+                e.text.erase(e.text.find_last_not_of(" \t") + 1);
+            } else if (!strcmp(arg, "estop")) {
+                e.kind = Event::ESTOP;
+            } else if (!strcmp(arg, "switch") && rest > 0
+                       && sscanf(line + rest, "%15s %15s", side, action) == 2
+                       && (!strcmp(side, "left") || !strcmp(side, "right"))
+                       && (!strcmp(action, "press") || !strcmp(action, "release"))) {
+                e.kind = Event::SWITCH;
+                e.pin = !strcmp(side, "left") ? Config::Motor2::LEFT_SWITCH_PIN : Config::Motor2::RIGHT_SWITCH_PIN;
+                e.level = !strcmp(action, "press") ? LOW : HIGH;
+            } else {
+                ok = false;
+            }
+            if (ok) s.events.push_back(e);
+        } else {
+            ok = false;
+        }
+        if (!ok) fprintf(stderr, "%s:%d: cannot parse '%s'\n", path.c_str(), lineNo, line);
+    }
+    fclose(f);
+
+    if (ok && s.endUs == 0) {
+        fprintf(stderr, "%s: missing 'end <ms>'\n", path.c_str());
+        ok = false;
+    }
+    std::stable_sort(s.events.begin(), s.events.end(),
+                     [](const Event& x, const Event& y) { return x.atUs < y.atUs; });
+    return ok;
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+bool collect(const std::string& path, std::vector<std::string>& files) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        if (access(path.c_str(), R_OK) != 0) return false;
+        files.push_back(path);
+        return true;
+    }
+    std::vector<std::string> found;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (endsWith(name, ".scn")) found.push_back(path + "/" + name);
+    }
+    closedir(dir);
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+    return !found.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    opt.jobs = max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(arg, "--update")) opt.update = true;
+        else if (!strcmp(arg, "-v")) opt.verbose = true;
+        else if (!strcmp(arg, "--power")) opt.power = true;
+        else if (value && !strcmp(arg, "--isr-cycles")) { opt.isrCycles = max(1, atoi(value)); i++; }
+        else if (value && !strcmp(arg, "--out")) { opt.outDir = value; i++; }
+        else if (value && !strcmp(arg, "-j")) { opt.jobs = max(1, atoi(value)); i++; }
+        else if (value && !strcmp(arg, "--repeat")) { opt.repeat = max(1, atoi(value)); i++; }
+        else if (arg[0] == '-') {
+            fprintf(stderr, "Bad option: %s (see header of tools/replay/replay.cpp)\n", arg);
+            return 2;
+        } else if (!collect(arg, files)) {
+            fprintf(stderr, "No scenario at %s\n", arg);
+            return 2;
+        }
+    }
+    // Default: the checked-in scenarios, from the repo root or from tools/
+    if (files.empty() && !collect("tools/replay/scenarios", files) && !collect("replay/scenarios", files)) {
+        fprintf(stderr, "No scenarios given\n");
+        return 2;
+    }
+
+    std::vector<Scenario> scenarios(files.size());
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!parseScenario(files[i], scenarios[i])) return 2;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    size_t total = scenarios.size() * opt.repeat;
+    size_t launched = 0, active = 0;
+    unsigned failed = 0, errors = 0;
+    double simulatedS = 0;
+    fflush(stdout);
+
+    while (launched < total || active > 0) {
+        while (launched < total && active < opt.jobs) {
+            const Scenario& s = scenarios[launched % scenarios.size()];
+            unsigned run = (unsigned)(launched / scenarios.size());
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                return 2;
+            }
+            if (pid == 0) _exit(runChild(s, run, opt));
+            simulatedS += s.endUs / 1e6;
+            launched++;
+            active++;
+        }
+        int status = 0;
+        if (wait(&status) < 0) break;
+        active--;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) == 2) errors++;
+        else if (WEXITSTATUS(status) == 1) failed++;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    printf("%zu runs (%zu scenarios x %u), %.0f s simulated in %.2f s on %u jobs: %zu passed, %u failed, %u errors\n",
+           total, scenarios.size(), opt.repeat, simulatedS, elapsed, opt.jobs,
+           total - failed - errors, failed, errors);
+    if (opt.update) printf("Golden traces %s\n", errors ? "NOT all written" : "written");
+    return (failed || errors) ? 1 : 0;
+}
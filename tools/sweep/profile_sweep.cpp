@@ -0,0 +1,418 @@
+/**
+ * Parallel motion profile parameter sweep (host)
+ *
+ * Simulates every combination of TARGET_RPM, ACCEL_ZONE, DECEL_ZONE,
+ * POWER_CURVE and MIN_SPEED_FACTOR per axis with the firmware's own
+ * SpeedProfile and step timing (timer period, PROFILE_UPDATE_STEPS updates).
+ * Candidates use the axis' PROFILE_SHAPE unless --mN.shape picks another
+ * (power, trapezoid, scurve); POWER_CURVE is only swept for 'power'.
+ * Each combination is scored on move time, peak acceleration and peak jerk
+ * at the output shaft. Combinations within the limits form a Pareto front
+ * per axis. The axes are then paired into the fastest seq1 cycle and the
+ * result is printed as a Config.h snippet.
+ *
+ * Limits default to what the current Config.h values produce, so the
+ * recommendation never asks more of the motors than the hand-tuned setup.
+ * The Config.h values are always swept too, even when they fall between
+ * grid points (Motor 2's 0.018 zones, for example).
+ *
+ * Usage: profile_sweep [--threads N] [--range-deg D] [--top N] [--front-csv FILE]
+ *                      [--m1.rpm lo:hi:step] [--m1.accel ...] [--m1.decel ...]
+ *                      [--m1.power ...] [--m1.min ...] [--m1.shape power|trapezoid|scurve]
+ *                      [--m1.max-accel X] [--m1.max-jerk X] [--m1.max-start-rpm X]
+ *                      (same options with m2.)
+ */
+
+#include <Arduino.h>
+#include "SpeedProfile.h"
+#include "MainMotor.h"
+#include "OscillationMotor.h"
+#include "Config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Range {
+    float lo, hi, step;
+    std::vector<float> values() const {
+        std::vector<float> v;
+        for (int i = 0; lo + i * step <= hi + step * 1e-3f; i++) v.push_back(lo + i * step);
+        return v;
+    }
+};
+
+struct Candidate {
+    float rpm, accelZone, decelZone, powerCurve, minSpeedFactor;
+};
+
+struct Metrics {
+    double moveMs = 0;
+    double maxAccel = 0;    // deg/s² at output shaft
+    double maxJerk = 0;     // deg/s³ at output shaft
+    double startRpm = 0;    // Speed of the first and last steps
+};
+
+struct Result {
+    Candidate c;
+    Metrics m;
+    bool feasible;
+};
+
+struct Axis;
+typedef Metrics (*Simulator)(const Axis& ax, const Candidate& c);
+
+struct Axis {
+    const char* name;
+    const char* configNamespace;
+    uint16_t stepsPerRev;
+    uint8_t microsteps;
+    uint8_t gearRatio;
+    uint8_t updateSteps;
+    unsigned long moveSteps;
+    Candidate baseline;
+    Range rpm, accel, decel, power, minSpeed;
+    double maxAccel = -1, maxJerk = -1, maxStartRpm = -1;   // < 0: use baseline
+    Metrics baselineMetrics;
+    std::vector<Result> results;
+    Config::ProfileShape shape;         // Candidates' ramp shape
+    Simulator simulate = nullptr;
+    Simulator simulateBaseline = nullptr;   // Config.h shape
+};
+
+const char* shapeName(Config::ProfileShape shape) {
+    switch (shape) {
+        case Config::ProfileShape::TRAPEZOID: return "trapezoid";
+        case Config::ProfileShape::S_CURVE: return "scurve";
+        default: return "power";
+    }
+}
+
+const char* shapeConstant(Config::ProfileShape shape) {
+    switch (shape) {
+        case Config::ProfileShape::TRAPEZOID: return "ProfileShape::TRAPEZOID";
+        case Config::ProfileShape::S_CURVE: return "ProfileShape::S_CURVE";
+        default: return "ProfileShape::POWER_CURVE";
+    }
+}
+
+// One move with the firmware's timing: period = getTimerPeriod() / factor,
+// two timer interrupts per step, profile updated every updateSteps steps
+template <typename Profile>
+Metrics simulate(const Axis& ax, const Candidate& c) {
+    unsigned long stepsPerRotation = Profile::STEPS_PER_ROTATION;
+    float stepFreq = (c.rpm * ax.gearRatio / 60.0f) * ax.stepsPerRev * ax.microsteps;
+    unsigned long basePeriod = (unsigned long)(500000.0f / stepFreq);
+    double degPerStep = 360.0 / (double)stepsPerRotation;
+
+    SpeedProfile<Profile> profile({ c.accelZone, c.decelZone, c.powerCurve, c.minSpeedFactor });
+    profile.begin(ax.moveSteps);
+
+    Metrics m;
+    double t = 0;
+    double prevV = 0, prevA = 0, prevTc = 0;
+    int windows = 0;
+    unsigned long period = 0;
+    float firstFactor = 0, factor = 0;
+
+    for (unsigned long step = 0; step < ax.moveSteps; step += ax.updateSteps) {
+        factor = profile.factorAt(step);
+        if (step == 0) firstFactor = factor;
+        period = (unsigned long)(basePeriod / factor);
+        unsigned long n = min((unsigned long)ax.updateSteps, ax.moveSteps - step);
+        double dt = 2.0 * period * n;   // µs for this window
+
+        // Speed is constant inside a window; accel/jerk between window centres
+        double v = n * degPerStep / (dt * 1e-6);
+        double tc = t + dt / 2;
+        if (windows > 0) {
+            double a = (v - prevV) / ((tc - prevTc) * 1e-6);
+            m.maxAccel = max(m.maxAccel, fabs(a));
+            if (windows > 1) m.maxJerk = max(m.maxJerk, fabs(a - prevA) / ((tc - prevTc) * 1e-6));
+            prevA = a;
+        }
+        prevV = v;
+        prevTc = tc;
+        t += dt;
+        windows++;
+    }
+
+    m.moveMs = t / 1000.0;
+    m.startRpm = max(firstFactor, factor) * c.rpm;
+    return m;
+}
+
+// The axis' descriptor with the ramp shape chosen at run time
+template <typename Profile>
+Simulator simulatorFor(Config::ProfileShape shape) {
+    switch (shape) {
+        case Config::ProfileShape::TRAPEZOID:
+            return simulate<ProfileWithShape<Profile, Config::ProfileShape::TRAPEZOID>>;
+        case Config::ProfileShape::S_CURVE:
+            return simulate<ProfileWithShape<Profile, Config::ProfileShape::S_CURVE>>;
+        default:
+            return simulate<ProfileWithShape<Profile, Config::ProfileShape::POWER_CURVE>>;
+    }
+}
+
+std::vector<Candidate> grid(const Axis& ax) {
+    std::vector<Candidate> out;
+    for (float rpm : ax.rpm.values())
+        for (float accel : ax.accel.values())
+            for (float decel : ax.decel.values())
+                for (float power : ax.power.values())
+                    for (float minSpeed : ax.minSpeed.values())
+                        out.push_back({ rpm, accel, decel, power, minSpeed });
+
+    // The Config.h point is always a candidate, even off the grid, so the
+    // front can never miss the hand-tuned setup
+    const Candidate& b = ax.baseline;
+    auto same = [](float x, float y) { return fabsf(x - y) <= 1e-4f * max(1.0f, fabsf(y)); };
+    bool onGrid = std::any_of(out.begin(), out.end(), [&](const Candidate& c) {
+        return same(c.rpm, b.rpm) && same(c.accelZone, b.accelZone) && same(c.decelZone, b.decelZone) &&
+               same(c.powerCurve, b.powerCurve) && same(c.minSpeedFactor, b.minSpeedFactor);
+    });
+    if (!onGrid) out.push_back(b);
+    return out;
+}
+
+void runSweep(Axis& ax, unsigned threads) {
+    std::vector<Candidate> candidates = grid(ax);
+    ax.results.assign(candidates.size(), Result{});
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < candidates.size(); i = next++) {
+            Metrics m = ax.simulate(ax, candidates[i]);
+            bool ok = m.maxAccel <= ax.maxAccel && m.maxJerk <= ax.maxJerk && m.startRpm <= ax.maxStartRpm;
+            ax.results[i] = Result{ candidates[i], m, ok };
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) pool.emplace_back(worker);
+    for (std::thread& th : pool) th.join();
+}
+
+// Feasible results not beaten on all of (time, accel, jerk) by another
+std::vector<Result> paretoFront(const std::vector<Result>& results) {
+    std::vector<Result> feasible;
+    for (const Result& r : results) if (r.feasible) feasible.push_back(r);
+    std::sort(feasible.begin(), feasible.end(), [](const Result& a, const Result& b) {
+        if (a.m.moveMs != b.m.moveMs) return a.m.moveMs < b.m.moveMs;
+        if (a.m.maxAccel != b.m.maxAccel) return a.m.maxAccel < b.m.maxAccel;
+        return a.m.maxJerk < b.m.maxJerk;
+    });
+
+    std::vector<Result> front;
+    for (const Result& r : feasible) {
+        bool dominated = false;
+        for (const Result& f : front) {
+            if (f.m.maxAccel <= r.m.maxAccel && f.m.maxJerk <= r.m.maxJerk) { dominated = true; break; }
+        }
+        if (!dominated) front.push_back(r);
+    }
+    return front;
+}
+
+// seq1 half-cycle: the slower axis plus two direction-change settles
+double cycleSeconds(double m1Ms, double m2Ms) {
+    double half = max(m1Ms, m2Ms) + 2.0 * Config::Timing::DIR_CHANGE_DELAY_MS;
+    return 2.0 * half / 1000.0;
+}
+
+void printFront(const Axis& ax, const std::vector<Result>& front, size_t feasible, size_t top) {
+    printf("\n%s Pareto front, %s ramps (%zu points, %zu of %zu combinations within limits)\n",
+           ax.name, shapeName(ax.shape), front.size(), feasible, ax.results.size());
+    printf("  %6s %6s %6s %6s %6s %10s %12s %14s\n",
+           "rpm", "accel", "decel", "power", "min", "move_ms", "accel_dps2", "jerk_dps3");
+    for (size_t i = 0; i < front.size() && i < top; i++) {
+        const Result& r = front[i];
+        printf("  %6.2f %6.3f %6.3f %6.2f %6.2f %10.1f %12.1f %14.1f\n",
+               r.c.rpm, r.c.accelZone, r.c.decelZone, r.c.powerCurve, r.c.minSpeedFactor,
+               r.m.moveMs, r.m.maxAccel, r.m.maxJerk);
+    }
+    if (front.size() > top) printf("  ... %zu more\n", front.size() - top);
+}
+
+void writeFrontCsv(FILE* f, const Axis& ax, const std::vector<Result>& front) {
+    for (const Result& r : front) {
+        fprintf(f, "%s,%.3f,%.4f,%.4f,%.3f,%.3f,%.2f,%.2f,%.2f\n", ax.name,
+                r.c.rpm, r.c.accelZone, r.c.decelZone, r.c.powerCurve, r.c.minSpeedFactor,
+                r.m.moveMs, r.m.maxAccel, r.m.maxJerk);
+    }
+}
+
+void printSnippet(const Axis& ax, const Result& r) {
+    printf("    namespace %s {\n", ax.configNamespace);
+    printf("        constexpr float TARGET_RPM = %.2ff;\n", r.c.rpm);
+    printf("        constexpr float ACCEL_ZONE = %.3ff;\n", r.c.accelZone);
+    printf("        constexpr float DECEL_ZONE = %.3ff;\n", r.c.decelZone);
+    printf("        constexpr ProfileShape PROFILE_SHAPE = %s;\n", shapeConstant(ax.shape));
+    printf("        constexpr float POWER_CURVE = %.2ff;\n", r.c.powerCurve);
+    printf("        constexpr float MIN_SPEED_FACTOR = %.2ff;\n", r.c.minSpeedFactor);
+    printf("    }\n");
+}
+
+bool parseRange(const char* text, Range& r) {
+    return sscanf(text, "%f:%f:%f", &r.lo, &r.hi, &r.step) == 3 && r.step > 0 && r.hi >= r.lo;
+}
+
+bool parseShape(const char* text, Config::ProfileShape& shape) {
+    const Config::ProfileShape shapes[] = { Config::ProfileShape::POWER_CURVE, Config::ProfileShape::TRAPEZOID,
+                                            Config::ProfileShape::S_CURVE };
+    for (Config::ProfileShape s : shapes) {
+        if (!strcmp(text, shapeName(s))) {
+            shape = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseAxisOption(Axis& ax, const char* opt, const char* value) {
+    if (!strcmp(opt, "rpm")) return parseRange(value, ax.rpm);
+    if (!strcmp(opt, "accel")) return parseRange(value, ax.accel);
+    if (!strcmp(opt, "decel")) return parseRange(value, ax.decel);
+    if (!strcmp(opt, "power")) return parseRange(value, ax.power);
+    if (!strcmp(opt, "min")) return parseRange(value, ax.minSpeed);
+    if (!strcmp(opt, "shape")) return parseShape(value, ax.shape);
+    if (!strcmp(opt, "max-accel")) return (ax.maxAccel = atof(value)) > 0;
+    if (!strcmp(opt, "max-jerk")) return (ax.maxJerk = atof(value)) > 0;
+    if (!strcmp(opt, "max-start-rpm")) return (ax.maxStartRpm = atof(value)) > 0;
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace Config;
+
+    Axis m1 = { "Motor1", "Motor1", Motor1::STEPS_PER_REV, Motor1::MICROSTEPS, Motor1::GEAR_RATIO,
+                Motor1::PROFILE_UPDATE_STEPS, 0,
+                { Motor1::TARGET_RPM, Motor1::ACCEL_ZONE, Motor1::DECEL_ZONE, Motor1::POWER_CURVE, Motor1::MIN_SPEED_FACTOR },
+                { 10.0f, 25.0f, 2.5f }, { 0.025f, 0.2f, 0.025f }, { 0.025f, 0.2f, 0.025f },
+                { 0.5f, 2.0f, 0.25f }, { 0.05f, 0.25f, 0.05f }, -1, -1, -1, {}, {}, Motor1::PROFILE_SHAPE };
+    Axis m2 = { "Motor2", "Motor2", Motor2::STEPS_PER_REV, Motor2::MICROSTEPS, Motor2::GEAR_RATIO,
+                Motor2::PROFILE_UPDATE_STEPS, 0,
+                { Motor2::TARGET_RPM, Motor2::ACCEL_ZONE, Motor2::DECEL_ZONE, Motor2::POWER_CURVE, Motor2::MIN_SPEED_FACTOR },
+                { 2.5f, 10.0f, 1.25f }, { 0.025f, 0.2f, 0.025f }, { 0.025f, 0.2f, 0.025f },
+                { 0.5f, 2.0f, 0.25f }, { 0.05f, 0.25f, 0.05f }, -1, -1, -1, {}, {}, Motor2::PROFILE_SHAPE };
+
+    unsigned threads = max(1u, std::thread::hardware_concurrency());
+    float rangeDeg = 180.0f;
+    size_t top = 12;
+    const char* csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = value != nullptr;
+        if (ok && !strcmp(arg, "--threads")) threads = max(1, atoi(value));
+        else if (ok && !strcmp(arg, "--range-deg")) rangeDeg = (float)atof(value);
+        else if (ok && !strcmp(arg, "--top")) top = (size_t)atoi(value);
+        else if (ok && !strcmp(arg, "--front-csv")) csvPath = value;
+        else if (ok && !strncmp(arg, "--m1.", 5)) ok = parseAxisOption(m1, arg + 5, value);
+        else if (ok && !strncmp(arg, "--m2.", 5)) ok = parseAxisOption(m2, arg + 5, value);
+        else ok = false;
+        if (!ok) {
+            fprintf(stderr, "Bad option: %s (see header of tools/sweep/profile_sweep.cpp)\n", arg);
+            return 2;
+        }
+        i++;
+    }
+
+    // Move lengths exactly as seq1 computes them
+    unsigned long m1Rotation = (unsigned long)Motor1::GEAR_RATIO * Motor1::STEPS_PER_REV * Motor1::MICROSTEPS;
+    unsigned long m2Rotation = (unsigned long)Motor2::GEAR_RATIO * Motor2::STEPS_PER_REV * Motor2::MICROSTEPS;
+    m1.moveSteps = (unsigned long)((Motor1::SEQUENCE_DEGREES / 360.0f) * m1Rotation);
+    unsigned long homeRange = (unsigned long)((rangeDeg / 360.0f) * m2Rotation);
+    unsigned long offset = (unsigned long)((Motor2::OFFSET_DEGREES / 360.0f) * m2Rotation);
+    if (homeRange <= 2 * offset + 50) {
+        fprintf(stderr, "--range-deg too small for OFFSET_DEGREES\n");
+        return 2;
+    }
+    m2.moveSteps = homeRange - 2 * offset - 50;
+
+    m1.simulate = simulatorFor<Motor1Profile>(m1.shape);
+    m1.simulateBaseline = simulatorFor<Motor1Profile>(Motor1::PROFILE_SHAPE);
+    m2.simulate = simulatorFor<Motor2Profile>(m2.shape);
+    m2.simulateBaseline = simulatorFor<Motor2Profile>(Motor2::PROFILE_SHAPE);
+
+    Axis* axes[] = { &m1, &m2 };
+    for (Axis* ax : axes) {
+        if (ax->shape != ProfileShape::POWER_CURVE) {
+            ax->power = { ax->baseline.powerCurve, ax->baseline.powerCurve, 1.0f };   // Unused by the shape
+        }
+        ax->baselineMetrics = ax->simulateBaseline(*ax, ax->baseline);
+        if (ax->maxAccel < 0) ax->maxAccel = ax->baselineMetrics.maxAccel;
+        if (ax->maxJerk < 0) ax->maxJerk = ax->baselineMetrics.maxJerk;
+        if (ax->maxStartRpm < 0) ax->maxStartRpm = ax->baselineMetrics.startRpm;
+    }
+
+    printf("Baseline (include/Config.h), Motor2 range %.0f deg:\n", rangeDeg);
+    for (Axis* ax : axes) {
+        const Metrics& b = ax->baselineMetrics;
+        printf("  %s: move %.1f ms, accel %.1f deg/s2, jerk %.1f deg/s3, start %.2f rpm\n",
+               ax->name, b.moveMs, b.maxAccel, b.maxJerk, b.startRpm);
+    }
+    double baselineCycle = cycleSeconds(m1.baselineMetrics.moveMs, m2.baselineMetrics.moveMs);
+    printf("  seq1 cycle: %.2f s per oscillation\n", baselineCycle);
+    printf("Limits:\n");
+    for (Axis* ax : axes) {
+        printf("  %s: accel <= %.1f deg/s2, jerk <= %.1f deg/s3, start <= %.2f rpm\n",
+               ax->name, ax->maxAccel, ax->maxJerk, ax->maxStartRpm);
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    for (Axis* ax : axes) runSweep(*ax, threads);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    printf("\nSimulated %zu combinations on %u threads in %.2f s\n",
+           m1.results.size() + m2.results.size(), threads, elapsed);
+
+    FILE* csv = nullptr;
+    if (csvPath) {
+        csv = fopen(csvPath, "w");
+        if (!csv) { perror(csvPath); return 1; }
+        fprintf(csv, "axis,rpm,accel_zone,decel_zone,power_curve,min_speed_factor,move_ms,max_accel_dps2,max_jerk_dps3\n");
+    }
+
+    std::vector<Result> fronts[2];
+    for (int i = 0; i < 2; i++) {
+        fronts[i] = paretoFront(axes[i]->results);
+        size_t feasible = std::count_if(axes[i]->results.begin(), axes[i]->results.end(),
+                                        [](const Result& r) { return r.feasible; });
+        printFront(*axes[i], fronts[i], feasible, top);
+        if (csv) writeFrontCsv(csv, *axes[i], fronts[i]);
+    }
+    if (csv) fclose(csv);
+
+    if (fronts[0].empty() || fronts[1].empty()) {
+        printf("\nNo combination within limits for %s - widen the grid or the limits\n",
+               fronts[0].empty() ? m1.name : m2.name);
+        return 1;
+    }
+
+    // Fastest point of the slower axis sets the cycle; the other axis takes
+    // the gentlest front point that still finishes in time
+    int slow = fronts[0].front().m.moveMs >= fronts[1].front().m.moveMs ? 0 : 1;
+    const Result& slowPick = fronts[slow].front();
+    const Result* fastPick = &fronts[1 - slow].front();
+    for (const Result& r : fronts[1 - slow]) {
+        if (r.m.moveMs <= slowPick.m.moveMs && r.m.maxAccel < fastPick->m.maxAccel) fastPick = &r;
+    }
+    const Result& pick1 = slow == 0 ? slowPick : *fastPick;
+    const Result& pick2 = slow == 1 ? slowPick : *fastPick;
+
+    double cycle = cycleSeconds(pick1.m.moveMs, pick2.m.moveMs);
+    printf("\nRecommended: %.2f s per oscillation (baseline %.2f s, %+.1f%%), %s is the bottleneck\n",
+           cycle, baselineCycle, 100.0 * (cycle - baselineCycle) / baselineCycle, axes[slow]->name);
+    printf("\n// Generated by tools/sweep/profile_sweep - paste into include/Config.h\n");
+    printSnippet(m1, pick1);
+    printSnippet(m2, pick2);
+    return 0;
+}
@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+Reconstruct motion from a FairFan step trace and compare it with the plan.
+
+Reads the binary image sent by the 'tracedump' command (see
+include/StepTrace.h) from a capture file or straight from the controller,
+rebuilds position, velocity and acceleration per axis, overlays the planned
+SpeedProfile curve and flags:
+
+  jitter     - step interval spread while cruising (timer/ISR latency)
+  gaps       - intervals far longer than planned (missed or stalled steps)
+  staircase  - velocity held flat between profile updates in the ramps,
+               e.g. the 10 ms loop() update pattern
+
+Usage:
+    trace_analyze.py capture.bin [--csv out.csv] [--plot out.png]
+    trace_analyze.py --port /dev/ttyACM0 [--save capture.bin] [...]
+
+The capture file may be raw serial output: everything before the
+"TRACE BEGIN <bytes>" line is skipped.
+"""
+
+import argparse
+import math
+import re
+import statistics
+import struct
+import sys
+
+MAX_DELTA = 0x7FFF
+AXIS_NAMES = ("Motor1", "Motor2")
+AXIS_FMT = "<IfffffIIBBBB"
+SHAPES = ("power", "trapezoid", "s-curve")    # Config::ProfileShape
+SCURVE_SEGMENTS = 32
+AXIS_SIZE = struct.calcsize(AXIS_FMT)
+
+
+class AxisInfo:
+    def __init__(self, raw):
+        (self.steps_per_rotation, self.step_freq, self.accel_zone, self.decel_zone,
+         self.power_curve, self.min_speed_factor, self.move_steps, self.start_step,
+         self.update_steps, flags, self.shape, jerk_pct) = raw
+        self.profile_active = bool(flags & 1)
+        self.scurve_table = scurve_table(jerk_pct / 100.0) if self.shape == 2 else None
+        # Same truncation as StepperMotor::getTimerPeriod()
+        self.base_period_us = int(500000.0 / self.step_freq)
+
+    def factor_at(self, step, total_steps):
+        """Port of SpeedProfile::factorAt()."""
+        if not self.profile_active:
+            return 1.0
+        accel_end = int(self.steps_per_rotation * self.accel_zone)
+        decel_zone = int(self.steps_per_rotation * self.decel_zone)
+        decel_start = total_steps - decel_zone if total_steps > decel_zone else 0
+        if accel_end <= step <= decel_start:
+            return 1.0
+        accel = 1.0
+        if accel_end:
+            accel = max(self.ramp(step / accel_end), self.min_speed_factor)
+        decel = 1.0
+        if step > decel_start and total_steps > decel_start:
+            progress = (total_steps - step) / (total_steps - decel_start)
+            decel = max(self.ramp(progress), self.min_speed_factor)
+        return min(accel, decel)
+
+    def ramp(self, progress):
+        """Port of RampShape<SHAPE>::factor()."""
+        if self.shape == 1:
+            return math.sqrt(progress)
+        if self.shape == 2:
+            if progress >= 1.0:
+                return 1.0
+            x = progress * SCURVE_SEGMENTS
+            i = int(x)
+            a, b = self.scurve_table[i], self.scurve_table[i + 1]
+            return a + (b - a) * (x - i)
+        return progress ** self.power_curve
+
+    def planned_interval_us(self, step, total_steps, n):
+        """Time for n steps at the planned speed (two timer ticks per step)."""
+        return 2.0 * n * int(self.base_period_us / self.factor_at(step, total_steps))
+
+
+def scurve_table(jerk):
+    """Same points as SCurve::Table in include/SpeedProfile.h."""
+    accel = 1.0 / (1.0 - jerk / 2)
+
+    def velocity(t):
+        if t <= jerk / 2:
+            return accel * t * t / jerk
+        if t <= 1 - jerk / 2:
+            return accel * (t - jerk / 4)
+        return 1 - accel * (1 - t) ** 2 / jerk
+
+    def position(t):
+        if t <= jerk / 2:
+            p = accel * t ** 3 / (3 * jerk)
+        elif t <= 1 - jerk / 2:
+            p = accel * (jerk * jerk / 24 + ((t - jerk / 4) ** 2 - jerk * jerk / 16) / 2)
+        else:
+            p = 0.5 - (1 - t) + accel * (1 - t) ** 3 / (3 * jerk)
+        return 2 * p
+
+    table = []
+    for i in range(SCURVE_SEGMENTS + 1):
+        lo, hi = 0.0, 1.0
+        for _ in range(24):
+            mid = (lo + hi) / 2
+            if position(mid) < i / SCURVE_SEGMENTS:
+                lo = mid
+            else:
+                hi = mid
+        table.append(velocity((lo + hi) / 2))
+    return table
+
+
+def extract_image(data):
+    m = re.search(rb"TRACE BEGIN (\d+)\r?\n", data)
+    if m:
+        start = m.end()
+        return data[start:start + int(m.group(1))]
+    if data[:4] == b"FFTR":
+        return data
+    raise ValueError("no trace image found (expected 'TRACE BEGIN' or FFTR magic)")
+
+
+def parse(image):
+    if image[:4] != b"FFTR":
+        raise ValueError("bad magic")
+    version, decimation, count = struct.unpack_from("<BBH", image, 4)
+    if version != 1:
+        raise ValueError("unsupported trace version %d" % version)
+    off = 8
+    axes = []
+    for _ in range(2):
+        axes.append(AxisInfo(struct.unpack_from(AXIS_FMT, image, off)))
+        off += AXIS_SIZE
+    if len(image) < off + 2 * count:
+        raise ValueError("truncated trace: %d of %d entries" % ((len(image) - off) // 2, count))
+    entries = struct.unpack_from("<%dH" % count, image, off)
+    return decimation, axes, entries
+
+
+def read_port(port, baud, timeout):
+    import serial  # pyserial, only needed for live capture
+    with serial.Serial(port, baud, timeout=timeout) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"tracedump\n")
+        data = b""
+        while b"TRACE END" not in data:
+            chunk = ser.read(4096)
+            if not chunk:
+                break
+            data += chunk
+    return data
+
+
+class Segment:
+    """Consecutive entries of one axis without a saturated gap."""
+
+    def __init__(self, start_pos):
+        self.start_pos = start_pos   # Step index of the first entry within its move
+        self.times = []              # µs, end of each logged interval
+        self.deltas = []             # µs for `decimation` steps
+
+
+def split_segments(entries, axes, n):
+    """Every entry stands for n steps, so positions follow from the entry
+    count; a saturated delta only breaks the time base."""
+    segments = {0: [], 1: []}
+    clock = {0: 0, 1: 0}
+    pos = {}
+    for e in entries:
+        axis = e >> 15
+        delta = e & MAX_DELTA
+        clock[axis] += delta
+        segs = segments[axis]
+        info = axes[axis]
+        if not segs:
+            # Trigger: position known from the header (the other axis logs
+            # its next step right after the trigger)
+            pos[axis] = info.start_step + (0 if delta == 0 else 1)
+            segs.append(Segment(pos[axis]))
+            segs[-1].times.append(clock[axis])
+            continue
+        pos[axis] += n
+        if info.profile_active and pos[axis] > info.move_steps:
+            pos[axis] -= info.move_steps     # seq1: next move of the same length
+        if delta >= MAX_DELTA:
+            segs.append(Segment(pos[axis]))  # Interval too long to time
+        else:
+            segs[-1].deltas.append(delta)
+        segs[-1].times.append(clock[axis])
+    return segments
+
+
+def analyze_segment(info, seg, n, opts):
+    # seq1 moves repeat the same length, so the triggering move's length is
+    # used for every segment of the axis
+    total = info.move_steps
+    rows = []
+    pos = seg.start_pos
+    for i, delta in enumerate(seg.deltas):
+        pos += n
+        if pos > total and info.profile_active:
+            pos -= total
+        t_mid = seg.times[i + 1] - delta / 2.0
+        v = n / (delta * 1e-6)
+        planned = n / (info.planned_interval_us(pos - n / 2.0, total, n) * 1e-6)
+        rows.append([t_mid, pos, v, 0.0, planned])
+
+    # Acceleration: central difference of velocity
+    for i in range(1, len(rows) - 1):
+        dt = (rows[i + 1][0] - rows[i - 1][0]) * 1e-6
+        if dt > 0:
+            rows[i][3] = (rows[i + 1][2] - rows[i - 1][2]) / dt
+
+    findings = []
+    cruise = info.step_freq
+
+    # Gaps: much longer than planned
+    for i, r in enumerate(rows):
+        expected = r[4]
+        if r[2] < expected / opts.gap_factor:
+            findings.append("gap at %.1f ms: %.0f us for %d steps (planned %.0f us)"
+                            % (r[0] / 1000.0, seg.deltas[i], n, n / expected * 1e6))
+
+    # Jitter: spread of step intervals while cruising
+    cruising = [seg.deltas[i] for i, r in enumerate(rows) if r[4] >= cruise * (1 - 1e-6)]
+    jitter = None
+    if len(cruising) >= 4:
+        med = statistics.median(cruising)
+        devs = [abs(d - med) for d in cruising]
+        jitter = (statistics.pstdev(cruising), max(devs), med)
+        if max(devs) > opts.jitter_pct / 100.0 * med:
+            findings.append("jitter while cruising: max %.0f us on %.0f us (%.1f%%)"
+                            % (max(devs), med, 100.0 * max(devs) / med))
+
+    # Staircase: velocity held flat while the plan keeps changing
+    plateaus = []
+    run_start = 0
+    tol = opts.plateau_pct / 100.0
+    for i in range(1, len(rows) + 1):
+        same = i < len(rows) and abs(rows[i][2] - rows[run_start][2]) <= tol * rows[run_start][2]
+        if not same:
+            run = rows[run_start:i]
+            in_ramp = all(r[4] < cruise * (1 - 1e-6) for r in run)
+            plan_moved = abs(run[-1][4] - run[0][4]) > tol * cruise
+            if in_ramp and plan_moved and len(run) >= 2:
+                span_ms = (rows[i - 1][0] - rows[run_start][0]) / 1000.0
+                plateaus.append((span_ms, (i - run_start) * n))
+            run_start = i
+    jumps = [abs(rows[i][2] - rows[i - 1][2]) / cruise for i in range(1, len(rows))]
+    max_jump = max(jumps) if jumps else 0.0
+    if plateaus:
+        longest = max(p[0] for p in plateaus)
+        mean_ms = statistics.mean(p[0] for p in plateaus)
+        if longest >= opts.staircase_ms:
+            note = " (matches the 10 ms loop() update)" if 7.0 <= mean_ms <= 13.0 else ""
+            findings.append("staircase in ramps: %d flat steps, mean %.1f ms, longest %.1f ms, "
+                            "largest jump %.1f%% of cruise%s"
+                            % (len(plateaus), mean_ms, longest, 100 * max_jump, note))
+
+    rms_err = math.sqrt(sum(((r[2] - r[4]) / cruise) ** 2 for r in rows) / len(rows))
+
+    return rows, findings, {
+        "steps": len(rows) * n,
+        "duration_ms": (seg.times[-1] - seg.times[0]) / 1000.0,
+        "peak_rpm": max((r[2] for r in rows), default=0) * 60.0 / info.steps_per_rotation,
+        "jitter": jitter,
+        "rms_err": rms_err,
+        "plateaus": len(plateaus),
+        "max_jump": max_jump,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("capture", nargs="?", help="binary dump or raw serial capture")
+    parser.add_argument("--port", help="read live from the controller (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--save", help="write the captured image to this file")
+    parser.add_argument("--csv", help="write reconstructed samples")
+    parser.add_argument("--plot", help="write velocity/acceleration plot (needs matplotlib)")
+    parser.add_argument("--gap-factor", type=float, default=3.0,
+                        help="flag intervals longer than this multiple of planned (default 3)")
+    parser.add_argument("--jitter-pct", type=float, default=10.0,
+                        help="flag cruise interval deviation above this percent (default 10)")
+    parser.add_argument("--plateau-pct", type=float, default=1.0,
+                        help="velocity tolerance for a flat step (default 1%%)")
+    parser.add_argument("--staircase-ms", type=float, default=5.0,
+                        help="flag flat steps in the ramps longer than this (default 5 ms)")
+    opts = parser.parse_args()
+
+    if opts.port:
+        data = read_port(opts.port, opts.baud, 2.0)
+    elif opts.capture:
+        with open(opts.capture, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    image = extract_image(data)
+    if opts.save:
+        with open(opts.save, "wb") as f:
+            f.write(image)
+    n, axes, entries = parse(image)
+    print("Trace: %d entries, every %d steps" % (len(entries), n))
+
+    samples = []
+    problems = 0
+    for axis, segs in split_segments(entries, axes, n).items():
+        info = axes[axis]
+        for k, seg in enumerate(segs):
+            if len(seg.deltas) < 2:
+                continue
+            rows, findings, s = analyze_segment(info, seg, n, opts)
+            print("\n%s segment %d: steps %d-%d in %.1f ms, peak %.2f rpm%s"
+                  % (AXIS_NAMES[axis], k, seg.start_pos, seg.start_pos + s["steps"], s["duration_ms"],
+                     s["peak_rpm"], "" if info.profile_active else " (profile off, e.g. homing)"))
+            print("  velocity error vs plan: %.2f%% RMS of cruise" % (100 * s["rms_err"]))
+            if s["jitter"]:
+                print("  cruise interval: median %.0f us, stdev %.1f us, max dev %.0f us"
+                      % (s["jitter"][2], s["jitter"][0], s["jitter"][1]))
+            for line in findings:
+                print("  ! " + line)
+            problems += len(findings)
+            for r in rows:
+                samples.append((AXIS_NAMES[axis], k) + tuple(r))
+
+    if opts.csv:
+        with open(opts.csv, "w") as f:
+            f.write("axis,segment,time_us,position_steps,velocity_sps,accel_sps2,planned_sps\n")
+            for s in samples:
+                f.write("%s,%d,%.1f,%d,%.2f,%.1f,%.2f\n" % s)
+
+    if opts.plot:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+        fig, (ax_v, ax_a) = plt.subplots(2, 1, sharex=True, figsize=(11, 7))
+        for name in AXIS_NAMES:
+            pts = [s for s in samples if s[0] == name]
+            if not pts:
+                continue
+            t = [p[2] / 1000.0 for p in pts]
+            ax_v.plot(t, [p[4] for p in pts], ".", ms=2, label=name + " measured")
+            ax_v.plot(t, [p[6] for p in pts], "-", lw=1, label=name + " planned")
+            ax_a.plot(t, [p[5] for p in pts], lw=0.8, label=name)
+        ax_v.set_ylabel("velocity [steps/s]")
+        ax_a.set_ylabel("acceleration [steps/s²]")
+        ax_a.set_xlabel("time since trigger [ms]")
+        ax_v.legend()
+        ax_a.legend()
+        fig.tight_layout()
+        fig.savefig(opts.plot, dpi=120)
+        print("\nPlot written to %s" % opts.plot)
+
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())